@@ -0,0 +1,68 @@
+#include "AllocationCounter.h"
+
+#ifdef PEA_COUNT_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+thread_local long long allocations = 0;
+
+void* allocate(std::size_t size) {
+    allocations++;
+    void* memory = std::malloc(size > 0 ? size : 1);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    allocations++;
+    const std::size_t align = (std::size_t)alignment;
+    void* memory = std::aligned_alloc(align, (size + align - 1) / align * align); // Rozmiar - wielokrotność wyrównania.
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+}
+
+// Wersje tablicowe i nothrow z biblioteki standardowej wołają te poniżej.
+void* operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+long long allocationCount() {
+    return allocations;
+}
+
+#else
+
+long long allocationCount() {
+    return 0;
+}
+
+#endif
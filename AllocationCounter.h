@@ -0,0 +1,17 @@
+#ifndef PEA2_ALLOCATION_COUNTER_H
+#define PEA2_ALLOCATION_COUNTER_H
+
+// Diagnostyczny licznik alokacji sterty (opcja CMake PEA_COUNT_ALLOCATIONS). Zastępuje
+// globalne operator new i zlicza wywołania osobno w każdym wątku, więc solver może
+// sprawdzić, ile alokacji wykonała jego pętla główna. Bez opcji licznik zawsze zwraca 0,
+// a operator new pozostaje biblioteczny.
+#ifdef PEA_COUNT_ALLOCATIONS
+constexpr bool ALLOCATION_COUNTING = true;
+#else
+constexpr bool ALLOCATION_COUNTING = false;
+#endif
+
+// Liczba alokacji wykonanych dotąd przez bieżący wątek.
+long long allocationCount();
+
+#endif // PEA2_ALLOCATION_COUNTER_H
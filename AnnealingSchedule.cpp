@@ -0,0 +1,161 @@
+#include "AnnealingSchedule.h"
+#include "Moves.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+
+namespace {
+
+const double MIN_TEMPERATURE = 0.1;  // Poniżej tej temperatury przebieg uznawany jest za zamarznięty.
+const double FROZEN_ACCEPTANCE = 0.001;
+const int FROZEN_EPOCHS = 3;
+
+}
+
+AnnealingSchedule::AnnealingSchedule(const ScheduleOptions& options, double initialTemperature, double coolingRate, int n)
+    : options(options), initial(initialTemperature), rate(coolingRate), current(initialTemperature),
+      improvementTemperature(initialTemperature) {
+    // Lundy-Mees zmniejsza 1/T o stałe beta na epokę; beta dobrane tak, by cykl od T0
+    // do MIN_TEMPERATURE trwał tyle epok, co przy chłodzeniu geometrycznym.
+    const double geometricEpochs = initial > MIN_TEMPERATURE ? std::log(MIN_TEMPERATURE / initial) / std::log(rate) : 1.0;
+    beta = initial > MIN_TEMPERATURE ? (1.0 / MIN_TEMPERATURE - 1.0 / initial) / geometricEpochs : 0;
+    baseLength = options.epoch == EpochPolicy::Fixed ? 1000 : std::max(1000, n);
+    length = baseLength;
+}
+
+AnnealingSchedule::Action AnnealingSchedule::endEpoch(long long accepted, long long tried, bool improved, double progress) {
+    cycleEpochs++;
+    const double ratio = tried > 0 ? (double)accepted / tried : 0;
+    if (improved) {
+        improvementTemperature = current;
+    }
+
+    switch (options.cooling) {
+        case CoolingPolicy::Geometric:
+            current *= rate;
+            break;
+        case CoolingPolicy::LundyMees:
+            current = current / (1.0 + beta * current);
+            break;
+        case CoolingPolicy::TargetAcceptance: {
+            // Cel maleje wykładniczo z upływem czasu: 50% na starcie, 0.2% na końcu.
+            const double target = 0.5 * std::pow(0.004, std::min(1.0, std::max(0.0, progress)));
+            current = std::min(initial, ratio > target ? current * rate : current / rate);
+            break;
+        }
+    }
+
+    // Przy niskiej akceptacji równowaga wymaga dłuższych epok (do 10-krotności bazowej).
+    if (options.epoch == EpochPolicy::Adaptive) {
+        const double scale = ratio > 0 ? std::min(10.0, std::max(1.0, 0.1 / ratio)) : 10.0;
+        length = (int)(baseLength * scale);
+        frozenEpochs = ratio < FROZEN_ACCEPTANCE ? frozenEpochs + 1 : 0;
+    }
+
+    if (current <= MIN_TEMPERATURE || frozenEpochs >= FROZEN_EPOCHS) {
+        return reheat(false);
+    }
+    if (options.restart != RestartPolicy::Continue && stagnation.update(improved)) {
+        return reheat(true);
+    }
+    return Action::Continue;
+}
+
+AnnealingSchedule::State AnnealingSchedule::state() const {
+    return State{current, improvementTemperature, length, frozenEpochs, cycleEpochs, stagnation.idleSteps(),
+                 stagnation.stepLimit()};
+}
+
+void AnnealingSchedule::restore(const State& state) {
+    current = state.temperature;
+    improvementTemperature = state.improvementTemperature;
+    length = state.length;
+    frozenEpochs = state.frozenEpochs;
+    cycleEpochs = state.cycleEpochs;
+    stagnation.setLimit(state.stagnationLimit);
+    stagnation.restore(state.stagnationIdle);
+}
+
+// Pierwszy pełny cykl chłodzenia wyznacza limit stagnacji: tyle epok bez poprawy, ile trwał.
+// Po restarcie z najlepszej lub elitarnej trasy temperatura wraca tylko do dwukrotności tej,
+// przy której ostatnio znaleziono poprawę - pełne T0 rozbiłoby dobrą trasę w losową.
+AnnealingSchedule::Action AnnealingSchedule::reheat(bool stagnated) {
+    if (options.restart != RestartPolicy::Continue && cycleEpochs > 0) {
+        stagnation.setLimit(std::max(10LL, cycleEpochs));
+    }
+    cycleEpochs = 0;
+    frozenEpochs = 0;
+    stagnation.reset();
+    length = baseLength;
+    if (options.restart == RestartPolicy::Continue) {
+        current = initial;
+    } else {
+        current = std::min(initial, std::max(2.0 * improvementTemperature, 10.0 * MIN_TEMPERATURE));
+    }
+    return stagnated ? Action::Diversify : Action::Reheat;
+}
+
+// Próbki pochodzą z jednej losowej permutacji, dodatkowo mieszanej losową zamianą po
+// każdej próbce, zamiast z 10000 nowych permutacji.
+double estimateInitialTemperature(const MatrixView& matrix, Random& rng) {
+    const int size = matrix.size();
+    std::vector<int> origin(size); // Losowa permutacja wierzchołków.
+    std::iota(origin.begin(), origin.end(), 0);
+    std::shuffle(origin.begin(), origin.end(), rng);
+    int firstToSwap, secondToSwap; // Indeksy wierzchołków do zamiany.
+    long long buffer = 0; // Suma różnic do obliczenia średniej.
+
+    for (int i = 0; i < 10000; i++) {
+        // Losowe wybieranie dwóch różnych wierzchołków do zamiany.
+        do {
+            firstToSwap = rng.below(size);
+            secondToSwap = rng.below(size);
+        } while (firstToSwap == secondToSwap);
+
+        // Różnica kosztów między oryginalną a zmodyfikowaną permutacją.
+        buffer += std::abs(swapDelta(matrix, origin, firstToSwap, secondToSwap));
+        std::swap(origin[rng.below(size)], origin[rng.below(size)]); // Mieszanie permutacji przed kolejną próbką.
+    }
+    buffer /= 10000; // Średnia różnica kosztów.
+    return (-1.0 * buffer) / std::log(0.99);
+}
+
+void ElitePool::offer(const std::vector<int>& path, int cost) {
+    const size_t index = std::lower_bound(members.begin(), members.end(), cost,
+                                          [](const Member& member, int value) { return member.cost < value; })
+                         - members.begin();
+    if (index < members.size() && members[index].cost == cost) {
+        return; // Trasa o tym koszcie już jest w puli.
+    }
+    if ((int)members.size() >= capacity) {
+        if (index == members.size()) {
+            return;
+        }
+        // Pełna pula: bufor wypieranej, najgorszej trasy przyjmuje nową - bez alokacji.
+        Member recycled = std::move(members.back());
+        members.pop_back();
+        recycled.cost = cost;
+        recycled.path.assign(path.begin(), path.end());
+        members.insert(members.begin() + index, std::move(recycled));
+        return;
+    }
+    members.insert(members.begin() + index, Member{cost, path});
+}
+
+void doubleBridgeKick(std::vector<int>& path, int kicks, Random& rng) {
+    const int n = (int)path.size();
+    if (n < 4) {
+        return;
+    }
+    for (int k = 0; k < kicks; k++) {
+        // Trzy różne punkty cięcia 1 <= p1 < p2 < p3 <= n; segmenty B = [p1, p2) i C = [p2, p3).
+        int cuts[3];
+        cuts[0] = 1 + (int)rng.below(n);
+        do cuts[1] = 1 + (int)rng.below(n); while (cuts[1] == cuts[0]);
+        do cuts[2] = 1 + (int)rng.below(n); while (cuts[2] == cuts[0] || cuts[2] == cuts[1]);
+        std::sort(cuts, cuts + 3);
+        std::rotate(path.begin() + cuts[0], path.begin() + cuts[1], path.begin() + cuts[2]);
+    }
+}
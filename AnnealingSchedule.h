@@ -0,0 +1,131 @@
+#ifndef PEA2_ANNEALING_SCHEDULE_H
+#define PEA2_ANNEALING_SCHEDULE_H
+
+#include <vector>
+#include "DistanceMatrix.h"
+#include "Random.h"
+
+// Długość epoki (liczba ruchów na jednym poziomie temperatury).
+enum class EpochPolicy {
+    Fixed,    // Stałe 1000 ruchów.
+    Adaptive, // max(1000, n) ruchów, wydłużane do 10 razy przy niskim współczynniku akceptacji.
+};
+
+// Obniżanie temperatury po każdej epoce.
+enum class CoolingPolicy {
+    Geometric,        // T = rate * T.
+    LundyMees,        // T = T / (1 + beta * T), cykl chłodzenia tak długi jak przy geometrycznym.
+    TargetAcceptance, // T sterowane tak, by akceptacja śledziła cel malejący od 50% do 0.2% w czasie przebiegu.
+};
+
+// Stan, od którego przebieg jest kontynuowany po ponownym podgrzaniu.
+enum class RestartPolicy {
+    Continue, // Bieżące rozwiązanie i temperatura początkowa (dotychczasowe zachowanie).
+    Best,     // Najlepsza trasa, zaburzona przy stagnacji.
+    Elite,    // Losowa trasa z puli elitarnej, zaburzona przy stagnacji.
+};
+
+struct ScheduleOptions {
+    EpochPolicy epoch = EpochPolicy::Adaptive;
+    CoolingPolicy cooling = CoolingPolicy::Geometric;
+    RestartPolicy restart = RestartPolicy::Elite;
+};
+
+// Licznik kroków bez poprawy. Zgłasza stagnację po limit kolejnych krokach bez poprawy.
+class StagnationDetector {
+public:
+    explicit StagnationDetector(long long limit = 0) : limit(limit) {
+    }
+    void setLimit(long long steps) {
+        limit = steps;
+    }
+    bool update(bool improved) {
+        idle = improved ? 0 : idle + 1;
+        return limit > 0 && idle >= limit;
+    }
+    void reset() {
+        idle = 0;
+    }
+    long long idleSteps() const { return idle; }
+    long long stepLimit() const { return limit; }
+    void restore(long long steps) { // Wznowienie przebiegu z zapisanym licznikiem.
+        idle = steps;
+    }
+private:
+    long long limit;
+    long long idle = 0;
+};
+
+// Harmonogram temperatury SA. Po każdej epoce solver przekazuje liczbę przyjętych ruchów
+// i informację o poprawie najlepszego wyniku; harmonogram wylicza nową temperaturę i długość
+// epoki oraz decyduje o ponownym podgrzaniu (zamarznięcie lub stagnacja).
+class AnnealingSchedule {
+public:
+    enum class Action { Continue, Reheat, Diversify };
+
+    // Zmienna część harmonogramu (do zapisu stanu przebiegu); reszta wynika z parametrów konstruktora.
+    struct State {
+        double temperature;
+        double improvementTemperature;
+        int length;
+        int frozenEpochs;
+        long long cycleEpochs;
+        long long stagnationIdle;
+        long long stagnationLimit;
+    };
+
+    AnnealingSchedule(const ScheduleOptions& options, double initialTemperature, double coolingRate, int n);
+
+    double temperature() const { return current; }
+    int epochLength() const { return length; }
+    State state() const;
+    void restore(const State& state);
+
+    // progress - część limitu czasu, która już upłynęła (0..1).
+    Action endEpoch(long long accepted, long long tried, bool improved, double progress);
+
+private:
+    ScheduleOptions options;
+    double initial;
+    double rate;
+    double beta;                // Parametr chłodzenia Lundy'ego-Meesa.
+    double current;
+    double improvementTemperature; // Temperatura, w której ostatnio poprawiono najlepszy wynik.
+    int baseLength;
+    int length;
+    int frozenEpochs = 0;       // Kolejne epoki praktycznie bez akceptacji.
+    long long cycleEpochs = 0;  // Epoki od ostatniego podgrzania.
+    StagnationDetector stagnation;
+
+    Action reheat(bool stagnated);
+};
+
+// Pula kilku najlepszych, różnych kosztem tras (do restartów z RestartPolicy::Elite).
+class ElitePool {
+public:
+    explicit ElitePool(int capacity = 4) : capacity(capacity) {
+    }
+    void offer(const std::vector<int>& path, int cost);
+    bool empty() const { return members.empty(); }
+    int size() const { return (int)members.size(); }
+    const std::vector<int>& path(int i) const { return members[i].path; }
+    int cost(int i) const { return members[i].cost; }
+    const std::vector<int>& pick(Random& rng) const { return members[rng.below((uint32_t)members.size())].path; }
+private:
+    struct Member {
+        int cost;
+        std::vector<int> path;
+    };
+    int capacity;
+    std::vector<Member> members; // Posortowane rosnąco kosztem.
+};
+
+// Temperatura początkowa SA: przy średniej różnicy kosztu losowej zamiany dwóch pozycji
+// ruch pod górę jest przyjmowany z prawdopodobieństwem 0.99.
+double estimateInitialTemperature(const MatrixView& matrix, Random& rng);
+
+// Dywersyfikacja: kicks losowych przestawień "double bridge" (A B C D -> A C B D). Każde
+// zmienia tylko trzy krawędzie i nie odwraca segmentów, więc nadaje się dla ATSP.
+void doubleBridgeKick(std::vector<int>& path, int kicks, Random& rng);
+
+#endif // PEA2_ANNEALING_SCHEDULE_H
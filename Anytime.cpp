@@ -0,0 +1,91 @@
+#include "Anytime.h"
+#include "Checkpoint.h"
+
+#include <csignal>
+#include <iostream>
+
+namespace {
+
+std::atomic<bool> interrupted{false};
+
+extern "C" void onInterrupt(int signal) {
+    if (interrupted.load(std::memory_order_relaxed)) {
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+        return;
+    }
+    interrupted.store(true, std::memory_order_relaxed);
+}
+
+}
+
+AnytimeWriter::AnytimeWriter(const std::string& path) : path(path) {
+    writer = std::thread(&AnytimeWriter::run, this);
+}
+
+AnytimeWriter::~AnytimeWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    writer.join();
+}
+
+void AnytimeWriter::publish(const std::vector<int>& tour, int cost, double foundTime) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cost >= pendingCost) {
+            return;
+        }
+        pending = tour;
+        pendingCost = cost;
+        pendingTime = foundTime;
+        dirty = true;
+    }
+    changed.notify_all();
+}
+
+void AnytimeWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this]() { return !dirty && !writing; });
+}
+
+void AnytimeWriter::reset() {
+    flush();
+    std::lock_guard<std::mutex> lock(mutex);
+    pendingCost = INT_MAX;
+}
+
+// Trasa kopiowana jest pod blokadą, a zapisywana bez niej, więc publish() nie czeka na dysk.
+void AnytimeWriter::run() {
+    std::vector<int> tour;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [this]() { return dirty || stopping; });
+        if (!dirty) {
+            return;
+        }
+        tour = pending;
+        const int cost = pendingCost;
+        const double foundTime = pendingTime;
+        dirty = false;
+        writing = true;
+        lock.unlock();
+        if (!writeTourFile(path, tour, cost, foundTime)) {
+            std::cerr << "Nie mozna zapisac biezacego wyniku: " << path << std::endl;
+        }
+        lock.lock();
+        writing = false;
+        changed.notify_all();
+    }
+}
+
+void installInterruptHandler() {
+    std::signal(SIGINT, onInterrupt);
+    std::signal(SIGTERM, onInterrupt);
+}
+
+const std::atomic<bool>* interruptFlag() {
+    return &interrupted;
+}
@@ -0,0 +1,50 @@
+#ifndef PEA2_ANYTIME_H
+#define PEA2_ANYTIME_H
+
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Bieżący najlepszy wynik zapisywany na dysk w trakcie przebiegu. publish() tylko kopiuje
+// trasę i budzi wątek zapisujący, więc wątki solverów nie czekają na dysk; kolejne poprawy
+// zgłoszone w czasie zapisu łączą się w jedną. Plik (writeTourFile) jest podmieniany
+// atomowo, więc po przerwaniu programu zawsze zawiera kompletną, ostatnio zapisaną trasę.
+class AnytimeWriter {
+public:
+    explicit AnytimeWriter(const std::string& path);
+    ~AnytimeWriter(); // Zapisuje oczekującą trasę i kończy wątek.
+    AnytimeWriter(const AnytimeWriter&) = delete;
+    AnytimeWriter& operator=(const AnytimeWriter&) = delete;
+
+    // Gorsze od już zgłoszonej trasy są pomijane (poprawy z różnych wątków mogą przyjść
+    // w innej kolejności, niż zostały opublikowane w SharedBest).
+    void publish(const std::vector<int>& tour, int cost, double foundTime);
+    void flush();  // Czeka, aż ostatnia zgłoszona trasa będzie na dysku.
+    void reset();  // Nowy przebieg: zapomina koszt poprzedniego (plik zostaje do pierwszej poprawy).
+private:
+    std::string path;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<int> pending;
+    int pendingCost = INT_MAX;
+    double pendingTime = 0;
+    bool dirty = false;    // pending czeka na zapis.
+    bool writing = false;  // Wątek zapisuje trasę poza blokadą.
+    bool stopping = false;
+    std::thread writer;
+
+    void run();
+};
+
+// Obsługa SIGINT i SIGTERM: pierwszy sygnał ustawia tylko flagę, którą sterownik
+// równoległy przekazuje solverom jako flagę stopu - przebieg kończy się normalnie,
+// z zapisem stanu i wyników. Drugi sygnał przywraca domyślną obsługę (natychmiastowe
+// zakończenie).
+void installInterruptHandler();
+const std::atomic<bool>* interruptFlag();
+
+#endif // PEA2_ANYTIME_H
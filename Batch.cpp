@@ -0,0 +1,538 @@
+#include "Batch.h"
+#include "Anytime.h"
+#include "Checkpoint.h"
+#include "ExactSolver.h"
+#include "Generator.h"
+#include "ParallelSolver.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+// Znane optima instancji ATSP z biblioteki TSPLIB (klucz: nazwa pliku bez rozszerzenia).
+const map<string, int> KNOWN_OPTIMA = {
+    {"br17", 39},      {"ft53", 6905},    {"ft70", 38673},   {"ftv33", 1286},   {"ftv35", 1473},
+    {"ftv38", 1530},   {"ftv44", 1613},   {"ftv47", 1776},   {"ftv55", 1608},   {"ftv64", 1839},
+    {"ftv70", 1950},   {"ftv170", 2755},  {"kro124p", 36230}, {"p43", 5620},    {"rbg323", 1326},
+    {"rbg358", 1163},  {"rbg403", 2465},  {"rbg443", 2720},  {"ry48p", 14422},
+};
+
+struct BatchOptions {
+    vector<string> instances;
+    vector<SolverKind> algorithms{SolverKind::TabuSearch};
+    vector<uint64_t> seeds{1};
+    double searchTime = 5;
+    long long evaluationLimit = 0; // > 0 - przebieg kończy się także po tylu ocenionych ruchach.
+    double coolingRate = 0.99;
+    ScheduleOptions schedule;
+    int replicas = 0;
+    MemeticOptions memetic;
+    int tenure = 0;
+    int threads = 1;
+    int repetitions = 1;
+    string neighborhood = "full";
+    int candidates = 10;
+    double polishInterval = -1; // < 0 - bez przeszukiwania lokalnego.
+    int optimum = 0;            // 0 - z tabeli KNOWN_OPTIMA, jeśli instancja jest w niej.
+    double proofTime = 0;       // > 0 - limit solvera dokładnego dla instancji bez znanego optimum.
+    string generate;            // Zamiast przebiegów zapisz instancję z generatora do tego pliku.
+    string anytime;             // Plik z bieżącym najlepszym wynikiem przebiegu.
+    string checkpoint;          // Plik stanu TS/SA (przy wielu wątkach z numerem wątku).
+    double checkpointInterval = 0;
+    string resume;              // Kontynuacja TS/SA ze stanu zapisanego przez --checkpoint.
+    string warmStart;           // Trasa startowa TS/SA z pliku (np. wynikiTS.txt albo --anytime).
+    bool json = false;
+    string output;
+    string telemetry;               // Plik migawek JSON lines ("-" - standardowe wyjście błędów).
+    double telemetryInterval = 1.0;
+};
+
+void printUsage() {
+    cerr << "Uzycie: Pea2Projekt [opcje]\n"
+            "  --instance PLIK|gen:[RODZINA:]N[:ZIARNO]  instancja (mozna podac wiele razy); PLIK moze byc\n"
+            "                                  TSPLIB albo .bin, RODZINA: uniform|clustered|ftv\n"
+            "  --algorithm ts|sa|pt|ma|exact[,..]  algorytm(y), domyslnie ts (pt - wymiana replik SA, ma - memetyczny,\n"
+            "                                  exact - Held-Karp / podzial i ograniczenia)\n"
+            "  --time S                        czas na przebieg w sekundach, np. 0.5 (domyslnie 5)\n"
+            "  --evaluations N                 dodatkowo limit ocenionych ruchow (ts/sa - na watek)\n"
+            "  --cooling R                     wspolczynnik schladzania SA (domyslnie 0.99)\n"
+            "  --epoch fixed|adaptive          dlugosc epoki SA (domyslnie adaptive)\n"
+            "  --cooling-schedule geometric|lundy-mees|target  chlodzenie SA (domyslnie geometric)\n"
+            "  --restart continue|best|elite   punkt startowy SA po podgrzaniu (domyslnie elite)\n"
+            "  --replicas N                    liczba lancuchow pt (domyslnie max(8, watki))\n"
+            "  --population N                  liczba osobnikow ma (domyslnie 20..100 zaleznie od n)\n"
+            "  --crossover eax|ox              krzyzowanie ma (domyslnie eax)\n"
+            "  --selection tournament|rank|roulette  selekcja rodzicow ma (domyslnie tournament)\n"
+            "  --mutation P                    prawdopodobienstwo mutacji potomka ma (domyslnie 0.1)\n"
+            "  --tenure N                      dlugosc zakazu TS w krokach (domyslnie liczba miast)\n"
+            "  --seeds A[,B,..]                ziarna (domyslnie 1)\n"
+            "  --threads N                     liczba watkow na przebieg (0 - wszystkie rdzenie)\n"
+            "  --repeat N                      powtorzenia dla kazdego ziarna (ziarno + nr powtorzenia)\n"
+            "  --neighborhood full|swap|oropt|or3opt  sasiedztwo (domyslnie full)\n"
+            "  --candidates K                  dlugosc list kandydatow (domyslnie 10)\n"
+            "  --polish S                      przeszukiwanie lokalne co S sekund (0 - tylko na koncu)\n"
+            "  --optimum N                     znane optimum do wyliczenia luki\n"
+            "  --generate PLIK                 zapisz instancje gen:RODZINA:.. do PLIK (.bin) zamiast rozwiazywac\n"
+            "  --prove-optimum S               nieznane optimum wylicz solverem dokladnym w limicie S sekund\n"
+            "  --anytime PLIK                  kazda poprawa wyniku zapisywana do PLIK (trasa, koszt, czas)\n"
+            "  --checkpoint PLIK               ts/sa: stan przebiegu do PLIK (przy wielu watkach PLIK.NR)\n"
+            "  --checkpoint-interval S         zapis stanu co S sekund (domyslnie tylko na koncu przebiegu)\n"
+            "  --resume PLIK                   ts/sa: kontynuuj przebieg ze stanu zapisanego przez --checkpoint\n"
+            "                                  (przy tym samym --threads; blad pliku konczy sie statusem 1)\n"
+            "  --warm-start PLIK               ts/sa: trasa startowa z pliku zamiast zachlannej\n"
+            "  --format csv|json               format wynikow (json - jeden obiekt na wiersz)\n"
+            "  --output PLIK                   plik wynikow (domyslnie standardowe wyjscie)\n"
+            "  --telemetry PLIK|-              migawki postepu w JSON lines (- = stderr)\n"
+            "  --telemetry-interval S          odstep miedzy migawkami (domyslnie 1 s)\n";
+}
+
+vector<string> splitList(const string& text) {
+    vector<string> items;
+    stringstream stream(text);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+bool unknownValue(const string& key, const string& value) {
+    cerr << "Nieznana wartosc " << key << ": " << value << endl;
+    return false;
+}
+
+bool invalidValue(const string& key, const string& value, const string& expected) {
+    cerr << "Niepoprawna wartosc " << key << ": " << value << " (oczekiwano " << expected << ")" << endl;
+    return false;
+}
+
+// Liczby z wiersza poleceń: cała wartość musi być liczbą z podanego zakresu, inaczej
+// parseArguments() kończy się błędem (zamiast po cichu przyjąć 0 jak atoi).
+bool parseInteger(const string& key, const string& value, long long minimum, long long& number) {
+    char* end = nullptr;
+    errno = 0;
+    const long long parsed = strtoll(value.c_str(), &end, 10);
+    if (value.empty() || *end != '\0' || errno == ERANGE || parsed < minimum) {
+        return invalidValue(key, value, "liczby calkowitej >= " + to_string(minimum));
+    }
+    number = parsed;
+    return true;
+}
+
+bool parseInteger(const string& key, const string& value, int minimum, int& number) {
+    long long parsed;
+    if (!parseInteger(key, value, minimum, parsed)) {
+        return false;
+    }
+    if (parsed > INT_MAX) {
+        return invalidValue(key, value, "liczby calkowitej <= " + to_string(INT_MAX));
+    }
+    number = (int)parsed;
+    return true;
+}
+
+bool parseReal(const string& key, const string& value, double minimum, double maximum, double& number) {
+    char* end = nullptr;
+    const double parsed = strtod(value.c_str(), &end);
+    if (value.empty() || *end != '\0' || !(parsed >= minimum && parsed <= maximum)) {
+        ostringstream range;
+        range << "liczby z przedzialu [" << minimum << ", " << maximum << "]";
+        return invalidValue(key, value, range.str());
+    }
+    number = parsed;
+    return true;
+}
+
+// Liczba sekund (może być ułamkowa) - cała wartość musi być liczbą większą od zera.
+bool parseSeconds(const string& key, const string& value, double& seconds) {
+    char* end = nullptr;
+    const double parsed = strtod(value.c_str(), &end);
+    if (value.empty() || *end != '\0' || !(parsed > 0) || parsed > 1e9) {
+        cerr << "Niepoprawny czas " << key << ": " << value << " (oczekiwano liczby sekund > 0)" << endl;
+        return false;
+    }
+    seconds = parsed;
+    return true;
+}
+
+bool parseArguments(int argc, char* argv[], BatchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        string key = argv[i];
+        if (key == "--help" || key == "-h") {
+            return false;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Brak wartosci dla " << key << endl;
+            return false;
+        }
+        string value = argv[++i];
+        if (key == "--instance") {
+            options.instances.push_back(value);
+        } else if (key == "--algorithm") {
+            options.algorithms.clear();
+            for (const string& name : splitList(value)) {
+                if (name == "ts") options.algorithms.push_back(SolverKind::TabuSearch);
+                else if (name == "sa") options.algorithms.push_back(SolverKind::SimulatedAnnealing);
+                else if (name == "pt") options.algorithms.push_back(SolverKind::ParallelTempering);
+                else if (name == "ma") options.algorithms.push_back(SolverKind::Memetic);
+                else if (name == "exact") options.algorithms.push_back(SolverKind::Exact);
+                else {
+                    cerr << "Nieznany algorytm: " << name << endl;
+                    return false;
+                }
+            }
+        } else if (key == "--time") {
+            if (!parseSeconds(key, value, options.searchTime)) return false;
+        } else if (key == "--evaluations") {
+            if (!parseInteger(key, value, 0LL, options.evaluationLimit)) return false;
+        } else if (key == "--cooling") {
+            if (!parseReal(key, value, 0, 1, options.coolingRate)) return false;
+            if (options.coolingRate == 0 || options.coolingRate == 1) {
+                return invalidValue(key, value, "liczby z przedzialu (0, 1)");
+            }
+        } else if (key == "--epoch") {
+            if (value == "fixed") options.schedule.epoch = EpochPolicy::Fixed;
+            else if (value == "adaptive") options.schedule.epoch = EpochPolicy::Adaptive;
+            else return unknownValue(key, value);
+        } else if (key == "--cooling-schedule") {
+            if (value == "geometric") options.schedule.cooling = CoolingPolicy::Geometric;
+            else if (value == "lundy-mees") options.schedule.cooling = CoolingPolicy::LundyMees;
+            else if (value == "target") options.schedule.cooling = CoolingPolicy::TargetAcceptance;
+            else return unknownValue(key, value);
+        } else if (key == "--restart") {
+            if (value == "continue") options.schedule.restart = RestartPolicy::Continue;
+            else if (value == "best") options.schedule.restart = RestartPolicy::Best;
+            else if (value == "elite") options.schedule.restart = RestartPolicy::Elite;
+            else return unknownValue(key, value);
+        } else if (key == "--replicas") {
+            if (!parseInteger(key, value, 0, options.replicas)) return false;
+        } else if (key == "--population") {
+            if (!parseInteger(key, value, 0, options.memetic.population)) return false;
+            if (options.memetic.population == 1) {
+                return invalidValue(key, value, "0 albo co najmniej 2 osobnikow");
+            }
+        } else if (key == "--crossover") {
+            if (value == "eax") options.memetic.crossover = CrossoverKind::EdgeAssembly;
+            else if (value == "ox") options.memetic.crossover = CrossoverKind::Order;
+            else return unknownValue(key, value);
+        } else if (key == "--selection") {
+            if (value == "tournament") options.memetic.selection = SelectionKind::Tournament;
+            else if (value == "rank") options.memetic.selection = SelectionKind::Rank;
+            else if (value == "roulette") options.memetic.selection = SelectionKind::Roulette;
+            else return unknownValue(key, value);
+        } else if (key == "--mutation") {
+            if (!parseReal(key, value, 0, 1, options.memetic.mutation)) return false;
+        } else if (key == "--tenure") {
+            if (!parseInteger(key, value, 0, options.tenure)) return false;
+        } else if (key == "--seeds" || key == "--seed") {
+            options.seeds.clear();
+            for (const string& seed : splitList(value)) {
+                char* end = nullptr;
+                errno = 0;
+                const unsigned long long parsed = strtoull(seed.c_str(), &end, 10);
+                if (seed[0] < '0' || seed[0] > '9' || *end != '\0' || errno == ERANGE) {
+                    return invalidValue(key, seed, "nieujemnej liczby calkowitej");
+                }
+                options.seeds.push_back(parsed);
+            }
+        } else if (key == "--threads") {
+            if (!parseInteger(key, value, 0, options.threads)) return false;
+        } else if (key == "--repeat") {
+            if (!parseInteger(key, value, 1, options.repetitions)) return false;
+        } else if (key == "--neighborhood") {
+            options.neighborhood = value;
+        } else if (key == "--candidates") {
+            if (!parseInteger(key, value, 1, options.candidates)) return false;
+        } else if (key == "--polish") {
+            if (!parseReal(key, value, 0, 1e9, options.polishInterval)) return false;
+        } else if (key == "--optimum") {
+            if (!parseInteger(key, value, 0, options.optimum)) return false;
+        } else if (key == "--prove-optimum") {
+            if (!parseSeconds(key, value, options.proofTime)) return false;
+        } else if (key == "--generate") {
+            options.generate = value;
+        } else if (key == "--anytime") {
+            options.anytime = value;
+        } else if (key == "--checkpoint") {
+            options.checkpoint = value;
+        } else if (key == "--checkpoint-interval") {
+            if (!parseReal(key, value, 0, 1e9, options.checkpointInterval)) return false;
+        } else if (key == "--resume") {
+            options.resume = value;
+        } else if (key == "--warm-start") {
+            options.warmStart = value;
+        } else if (key == "--format") {
+            if (value == "csv") options.json = false;
+            else if (value == "json") options.json = true;
+            else return unknownValue(key, value);
+        } else if (key == "--output") {
+            options.output = value;
+        } else if (key == "--telemetry") {
+            options.telemetry = value;
+        } else if (key == "--telemetry-interval") {
+            if (!parseSeconds(key, value, options.telemetryInterval)) return false;
+        } else {
+            cerr << "Nieznana opcja: " << key << endl;
+            return false;
+        }
+    }
+    if (options.instances.empty() || options.algorithms.empty() || options.seeds.empty()) {
+        cerr << "Podaj co najmniej jedna instancje, algorytm i ziarno." << endl;
+        return false;
+    }
+    return true;
+}
+
+bool parseNeighborhood(const string& name, NeighborhoodKind& kind) {
+    if (name == "full") kind = NeighborhoodKind::FullSwap;
+    else if (name == "swap") kind = NeighborhoodKind::Swap;
+    else if (name == "oropt") kind = NeighborhoodKind::OrOpt;
+    else if (name == "or3opt") kind = NeighborhoodKind::Or3Opt;
+    else return false;
+    return true;
+}
+
+// "gen:N[:ZIARNO]" - instancja losowa jak w menu, "gen:RODZINA:N[:ZIARNO]" - instancja
+// z generatora (Generator.h); w przeciwnym razie plik TSPLIB albo ".bin".
+bool parseGenerated(const string& spec, GeneratorOptions& generator, bool& family) {
+    vector<string> parts;
+    stringstream stream(spec.substr(4));
+    string part;
+    while (getline(stream, part, ':')) parts.push_back(part);
+    family = !parts.empty() && parseInstanceFamily(parts[0], generator.family);
+    if (family) {
+        parts.erase(parts.begin());
+    }
+    char* sizeEnd = nullptr;
+    char* seedEnd = nullptr;
+    const long size = parts.empty() ? 0 : strtol(parts[0].c_str(), &sizeEnd, 10);
+    generator.size = size >= 3 && size <= INT_MAX ? (int)size : 0;
+    generator.seed = parts.size() > 1 ? strtoull(parts[1].c_str(), &seedEnd, 10) : 1;
+    if (generator.size < 3 || parts.size() > 2 || *sizeEnd != '\0' || (seedEnd != nullptr && *seedEnd != '\0')) {
+        cerr << "Niepoprawna instancja losowa: " << spec << endl;
+        return false;
+    }
+    return true;
+}
+
+bool loadInstance(const string& spec, Adjacency_Matrix& graph, string& name, WorkerPool* pool) {
+    if (spec.compare(0, 4, "gen:") == 0) {
+        GeneratorOptions generator;
+        bool family;
+        if (!parseGenerated(spec, generator, family)) {
+            return false;
+        }
+        if (family) {
+            graph.generate(InstanceGenerator(generator), pool);
+        } else {
+            graph.generate(generator.size, generator.seed);
+        }
+        name = spec;
+        return true;
+    }
+    size_t slash = spec.find_last_of("/\\");
+    name = spec.substr(slash == string::npos ? 0 : slash + 1);
+    name = name.substr(0, name.find('.'));
+    return graph.loadFromFile(spec, pool);
+}
+
+string jsonString(const string& text) {
+    string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+}
+
+int runBatch(int argc, char* argv[]) {
+    BatchOptions options;
+    NeighborhoodKind neighborhoodKind;
+    if (!parseArguments(argc, argv, options) || !parseNeighborhood(options.neighborhood, neighborhoodKind)) {
+        printUsage();
+        return 1;
+    }
+    const int threads = options.threads > 0 ? options.threads : (int)thread::hardware_concurrency();
+    unique_ptr<WorkerPool> pool(threads > 1 ? new WorkerPool(threads) : nullptr); // Generowanie i wczytywanie instancji.
+    if (!options.generate.empty()) {
+        GeneratorOptions generator;
+        bool family;
+        if (options.instances.size() != 1 || options.instances[0].compare(0, 4, "gen:") != 0
+            || !parseGenerated(options.instances[0], generator, family) || !family) {
+            cerr << "--generate wymaga jednej instancji gen:RODZINA:N[:ZIARNO]." << endl;
+            return 1;
+        }
+        if (!writeGeneratedInstance(options.generate, InstanceGenerator(generator), pool.get())) {
+            cerr << "Nie mozna zapisac instancji: " << options.generate << endl;
+            return 1;
+        }
+        return 0;
+    }
+    FILE* out = stdout;
+    if (!options.output.empty()) {
+        out = fopen(options.output.c_str(), "w");
+        if (out == nullptr) {
+            cerr << "Nie mozna otworzyc pliku wynikow: " << options.output << endl;
+            return 1;
+        }
+    }
+    unique_ptr<TelemetrySink> telemetry;
+    FILE* telemetryOut = nullptr;
+    if (!options.telemetry.empty()) {
+        if (!TELEMETRY_ENABLED) {
+            cerr << "Program zbudowano bez PEA_TELEMETRY - migawki nie beda zapisywane." << endl;
+        }
+        telemetryOut = options.telemetry == "-" ? stderr : fopen(options.telemetry.c_str(), "w");
+        if (telemetryOut == nullptr) {
+            cerr << "Nie mozna otworzyc pliku telemetrii: " << options.telemetry << endl;
+            return 1;
+        }
+        telemetry.reset(new TelemetrySink(telemetryOut, options.telemetryInterval));
+    }
+    unique_ptr<AnytimeWriter> anytime(options.anytime.empty() ? nullptr : new AnytimeWriter(options.anytime));
+    // SIGINT/SIGTERM kończy bieżący przebieg jak upływ czasu (z zapisem stanu i wiersza wyników)
+    // i pomija pozostałe.
+    installInterruptHandler();
+    const atomic<bool>& interrupted = *interruptFlag();
+    if (!options.json) {
+        fprintf(out, "instance,n,algorithm,neighborhood,threads,seed,time_budget,best_cost,time_to_best,"
+                     "optimum,gap_percent,evaluations,moves_per_second,elapsed\n");
+    }
+
+    int status = 0;
+    for (const string& spec : options.instances) {
+        if (interrupted) break;
+        Adjacency_Matrix graph;
+        string name;
+        if (!loadInstance(spec, graph, name, pool.get())) {
+            status = 1;
+            continue;
+        }
+        int optimum = options.optimum;
+        if (optimum == 0 && KNOWN_OPTIMA.count(name) != 0) {
+            optimum = KNOWN_OPTIMA.at(name);
+        }
+        if (optimum == 0 && options.proofTime > 0) {
+            ExactSolver exact(graph, options.proofTime);
+            exact.setThreads(threads);
+            SearchContext context;
+            context.stop = &interrupted;
+            Tour proof = exact.solve(context);
+            if (exact.proven()) {
+                optimum = proof.cost;
+            } else {
+                cerr << name << ": optimum nieudowodnione w " << options.proofTime << " s (dolne ograniczenie "
+                     << exact.lowerBound() << ", najlepsza trasa " << proof.cost << ")" << endl;
+            }
+        }
+        vector<int> initialTour;
+        if (!options.warmStart.empty()
+            && (!readTourFile(options.warmStart, initialTour) || !isTour(initialTour, graph.getNumVertices()))) {
+            cerr << name << ": plik " << options.warmStart << " nie zawiera trasy tej instancji." << endl;
+            status = 1;
+            continue;
+        }
+        Neighborhood neighborhood(graph.getView(), neighborhoodKind, options.candidates);
+
+        for (SolverKind algorithm : options.algorithms) {
+            if (interrupted) break;
+            for (uint64_t baseSeed : options.seeds) {
+                if (interrupted) break;
+                for (int run = 0; run < options.repetitions && !interrupted; run++) {
+                    ParallelOptions parallel;
+                    parallel.kind = algorithm;
+                    parallel.threads = options.threads;
+                    parallel.searchTime = options.searchTime;
+                    parallel.evaluationLimit = options.evaluationLimit;
+                    parallel.coolingRate = options.coolingRate;
+                    parallel.schedule = options.schedule;
+                    parallel.replicas = options.replicas;
+                    parallel.memetic = options.memetic;
+                    parallel.tabuTenure = options.tenure;
+                    parallel.seed = baseSeed + run;
+                    parallel.neighborhood = neighborhood;
+                    parallel.polish = options.polishInterval >= 0;
+                    parallel.polishInterval = options.polishInterval > 0 ? options.polishInterval : 0;
+                    parallel.telemetry = telemetry.get();
+                    parallel.anytime = anytime.get();
+                    parallel.interrupt = &interrupted;
+                    parallel.checkpoint = options.checkpoint;
+                    parallel.checkpointInterval = options.checkpointInterval;
+                    parallel.resume = options.resume;
+                    parallel.initialTour = initialTour;
+
+                    if (anytime != nullptr) {
+                        anytime->reset();
+                    }
+                    auto start = chrono::steady_clock::now();
+                    Tour best = solveParallel(graph, parallel);
+                    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                    if (anytime != nullptr) {
+                        anytime->flush();
+                    }
+                    if (best.path.empty()) {
+                        // Nie wczytano stanu z --resume (przyczyna wypisana przez solver) - bez wiersza wyników.
+                        cerr << name << ": nie mozna wznowic przebiegu z " << options.resume << endl;
+                        status = 1;
+                        continue;
+                    }
+
+                    const char* algorithmName = algorithm == SolverKind::TabuSearch ? "ts"
+                                              : algorithm == SolverKind::SimulatedAnnealing ? "sa"
+                                              : algorithm == SolverKind::ParallelTempering ? "pt"
+                                              : algorithm == SolverKind::Memetic ? "ma" : "exact";
+                    double rate = elapsed > 0 ? best.evaluations / elapsed : 0;
+                    // Nieznane optimum: puste pola w CSV, null w JSON.
+                    char optimumText[32] = "", gapText[32] = "";
+                    if (optimum > 0) {
+                        snprintf(optimumText, sizeof(optimumText), "%d", optimum);
+                        snprintf(gapText, sizeof(gapText), "%.4f", 100.0 * (best.cost - optimum) / optimum);
+                    }
+                    if (options.json) {
+                        fprintf(out, "{\"instance\":%s,\"n\":%d,\"algorithm\":\"%s\",\"neighborhood\":\"%s\",\"threads\":%d,"
+                                     "\"seed\":%llu,\"time_budget\":%g,\"best_cost\":%d,\"time_to_best\":%.6f,"
+                                     "\"optimum\":%s,\"gap_percent\":%s,\"evaluations\":%lld,"
+                                     "\"moves_per_second\":%.0f,\"elapsed\":%.6f}\n",
+                                jsonString(name).c_str(), graph.getNumVertices(), algorithmName, options.neighborhood.c_str(),
+                                options.threads, (unsigned long long)parallel.seed, options.searchTime, best.cost,
+                                best.foundTime, optimum > 0 ? optimumText : "null", optimum > 0 ? gapText : "null",
+                                best.evaluations, rate, elapsed);
+                    } else {
+                        fprintf(out, "%s,%d,%s,%s,%d,%llu,%g,%d,%.6f,%s,%s,%lld,%.0f,%.6f\n",
+                                name.c_str(), graph.getNumVertices(), algorithmName, options.neighborhood.c_str(),
+                                options.threads, (unsigned long long)parallel.seed, options.searchTime, best.cost,
+                                best.foundTime, optimumText, gapText, best.evaluations, rate, elapsed);
+                    }
+                    fflush(out);
+                }
+            }
+        }
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+    if (telemetryOut != nullptr && telemetryOut != stderr) {
+        fclose(telemetryOut);
+    }
+    if (interrupted) {
+        cerr << "Przerwano - wyniki i stan zapisane w chwili przerwania." << endl;
+        return 130; // Konwencja powłoki: 128 + SIGINT.
+    }
+    return status;
+}
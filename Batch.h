@@ -0,0 +1,8 @@
+#ifndef PEA2_BATCH_H
+#define PEA2_BATCH_H
+
+// Tryb wsadowy: uruchamia solvery dla instancji i ziaren podanych w argumentach wywołania
+// i wypisuje wyniki w formacie CSV albo JSON (jeden obiekt na wiersz). Zwraca kod wyjścia.
+int runBatch(int argc, char* argv[]);
+
+#endif // PEA2_BATCH_H
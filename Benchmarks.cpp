@@ -0,0 +1,339 @@
+// Mikrobenchmarki gorących jąder solverów (osobny program Pea2Benchmarks).
+//
+// Każdy pomiar powtarza operację w coraz większych seriach, aż seria trwa co najmniej
+// --min-time sekund, i podaje średni czas jednej operacji. Instancje są generowane ze
+// stałych ziaren, więc wyniki z różnych commitów dotyczą tych samych danych. Wynik w CSV
+// można zapisać (--output) i podać później jako --baseline: program wypisze stosunek
+// czasów i zwróci kod 2, jeśli któreś jądro zwolniło bardziej niż --tolerance.
+
+#include "adjacency_matrix.h"
+#include "AllocationCounter.h"
+#include "AnnealingSchedule.h"
+#include "Generator.h"
+#include "Greedy.h"
+#include "InstanceCache.h"
+#include "Metropolis.h"
+#include "Moves.h"
+#include "Neighborhood.h"
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+const uint64_t INSTANCE_SEED = 12345; // Ziarno instancji i permutacji - stałe między commitami.
+
+struct BenchmarkOptions {
+    vector<int> sizes{50, 100, 200, 500, 1000, 2000, 5000, 10000};
+    string filter;            // Tylko benchmarki, których nazwa zawiera ten tekst.
+    double minTime = 0.2;     // Minimalny czas serii pomiarowej w sekundach.
+    int maxLoadSize = 2000;   // Pliki tekstowe większych instancji byłyby zbyt duże.
+    string output;            // Plik CSV z wynikami (oprócz tabeli na standardowym wyjściu).
+    string baseline;          // Wcześniejszy plik CSV do porównania.
+    double tolerance = 0.10;  // Dopuszczalne względne spowolnienie względem baseline.
+};
+
+struct BenchmarkResult {
+    string name;
+    int n;
+    long long iterations;
+    double nanosPerOp;
+    double allocationsPerOp; // Tylko przy PEA_COUNT_ALLOCATIONS (inaczej 0).
+};
+
+volatile long long sink; // Odbiornik wyników, żeby kompilator nie usunął mierzonej pracy.
+
+void printUsage() {
+    cerr << "Uzycie: Pea2Benchmarks [opcje]\n"
+            "  --sizes A[,B,..]     liczby miast (domyslnie 50,100,200,500,1000,2000,5000,10000)\n"
+            "  --filter TEKST       tylko benchmarki zawierajace TEKST w nazwie\n"
+            "  --min-time S         minimalny czas serii pomiarowej (domyslnie 0.2)\n"
+            "  --max-load-size N    najwieksza instancja dla benchmarkow wczytywania (domyslnie 2000)\n"
+            "  --output PLIK        zapis wynikow w CSV\n"
+            "  --baseline PLIK      porownanie z wczesniejszym CSV\n"
+            "  --tolerance T        dopuszczalne spowolnienie, np. 0.1 = 10% (domyslnie 0.1)\n";
+}
+
+bool parseArguments(int argc, char* argv[], BenchmarkOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        string key = argv[i];
+        if (key == "--help" || key == "-h" || i + 1 >= argc) {
+            return false;
+        }
+        string value = argv[++i];
+        if (key == "--sizes") {
+            options.sizes.clear();
+            stringstream stream(value);
+            string item;
+            while (getline(stream, item, ',')) {
+                if (atoi(item.c_str()) >= 3) options.sizes.push_back(atoi(item.c_str()));
+            }
+        } else if (key == "--filter") {
+            options.filter = value;
+        } else if (key == "--min-time") {
+            options.minTime = atof(value.c_str());
+        } else if (key == "--max-load-size") {
+            options.maxLoadSize = atoi(value.c_str());
+        } else if (key == "--output") {
+            options.output = value;
+        } else if (key == "--baseline") {
+            options.baseline = value;
+        } else if (key == "--tolerance") {
+            options.tolerance = atof(value.c_str());
+        } else {
+            cerr << "Nieznana opcja: " << key << endl;
+            return false;
+        }
+    }
+    return !options.sizes.empty();
+}
+
+// Średni czas jednej operacji: serie podwajane (lub dopasowane do poprzedniego tempa),
+// aż jedna seria potrwa co najmniej minTime. Pierwsze wywołanie rozgrzewa pamięć podręczną.
+template <typename Operation>
+BenchmarkResult measure(const string& name, int n, double minTime, Operation&& operation) {
+    typedef chrono::steady_clock Clock;
+    operation();
+    long long iterations = 1;
+    while (true) {
+        const long long allocations = allocationCount();
+        Clock::time_point start = Clock::now();
+        for (long long i = 0; i < iterations; i++) {
+            operation();
+        }
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= minTime || iterations >= (1LL << 40)) {
+            return BenchmarkResult{name, n, iterations, seconds * 1e9 / iterations,
+                                   (double)(allocationCount() - allocations) / iterations};
+        }
+        long long estimate = seconds > 0 ? (long long)(iterations * 1.2 * minTime / seconds) : iterations * 10;
+        iterations = max(iterations * 2, min(estimate, iterations * 100));
+    }
+}
+
+// Losowa permutacja z ustalonego ziarna - ten sam punkt startowy w każdym pomiarze.
+vector<int> fixedPermutation(int n) {
+    vector<int> path(n);
+    for (int i = 0; i < n; i++) path[i] = i;
+    Random rng(INSTANCE_SEED);
+    shuffle(path.begin(), path.end(), rng);
+    return path;
+}
+
+// Zapis instancji jako ATSP w formacie FULL_MATRIX (wejście benchmarków wczytywania).
+bool writeTsplib(const string& filename, const MatrixView& matrix) {
+    ofstream file(filename);
+    file << "NAME: bench" << matrix.size() << "\nTYPE: ATSP\nDIMENSION: " << matrix.size()
+         << "\nEDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: FULL_MATRIX\nEDGE_WEIGHT_SECTION\n";
+    for (int i = 0; i < matrix.size(); i++) {
+        const Weight* row = matrix.row(i);
+        for (int j = 0; j < matrix.size(); j++) {
+            file << row[j] << (j + 1 < matrix.size() ? ' ' : '\n');
+        }
+    }
+    file << "EOF\n";
+    return (bool)file;
+}
+
+// Uruchamia pomiary wybrane filtrem i wypisuje wiersz tabeli dla każdego z nich.
+struct KernelBenchmarks {
+    const BenchmarkOptions& options;
+    vector<BenchmarkResult>& results;
+
+    bool selected(const string& name) const {
+        return options.filter.empty() || name.find(options.filter) != string::npos;
+    }
+
+    template <typename Operation>
+    void run(const string& name, int n, Operation&& operation) {
+        if (!selected(name)) {
+            return;
+        }
+        results.push_back(measure(name, n, options.minTime, operation));
+        const BenchmarkResult& result = results.back();
+        printf("%-24s %6d %14.1f %12lld", name.c_str(), n, result.nanosPerOp, result.iterations);
+        if (ALLOCATION_COUNTING) {
+            printf(" %10.2f", result.allocationsPerOp);
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+
+    void instance(int n) {
+        run("matrix/generate", n, [&] {
+            Adjacency_Matrix graph;
+            graph.generate(n, INSTANCE_SEED);
+            sink += graph.getView()(0, 1);
+        });
+        GeneratorOptions clustered;
+        clustered.family = InstanceFamily::Clustered;
+        clustered.size = n;
+        clustered.seed = INSTANCE_SEED;
+        run("matrix/clustered", n, [&] {
+            Adjacency_Matrix graph;
+            graph.generate(InstanceGenerator(clustered));
+            sink += graph.getView()(0, 1);
+        });
+        if (n > options.maxLoadSize || (!selected("matrix/load_tsplib") && !selected("matrix/load_cache"))) {
+            return;
+        }
+        Adjacency_Matrix source;
+        source.generate(n, INSTANCE_SEED);
+        string filename = (filesystem::temp_directory_path() / ("pea2_bench_" + to_string(n) + ".atsp")).string();
+        if (!writeTsplib(filename, source.getView())) {
+            cerr << "Nie mozna zapisac " << filename << endl;
+            return;
+        }
+        // Parsowanie tekstu (razem z zapisem kopii binarnej, jak przy pierwszym wczytaniu).
+        run("matrix/load_tsplib", n, [&] {
+            remove(instanceCachePath(filename).c_str());
+            Adjacency_Matrix graph;
+            sink += graph.loadFromFile(filename);
+        });
+        // Ponowne wczytanie z kopii binarnej.
+        run("matrix/load_cache", n, [&] {
+            Adjacency_Matrix graph;
+            sink += graph.loadFromFile(filename);
+        });
+        remove(instanceCachePath(filename).c_str());
+        remove(filename.c_str());
+    }
+
+    // Jądra przeglądu sąsiedztwa używane przez TS: koszt trasy, start zachłanny, pełny
+    // przegląd zamian (swapDelta dla wszystkich par) i przegląd or-3opt z list kandydatów.
+    void moves(const Adjacency_Matrix& graph) {
+        const int n = graph.getNumVertices();
+        const MatrixView matrix = graph.getView();
+        const vector<int> permutation = fixedPermutation(n);
+        run("moves/tour_cost", n, [&] { sink += tourCost(matrix, permutation); });
+        run("greedy/nearest_neighbor", n, [&] { sink += greedyTour(matrix, 0)[n - 1]; });
+        run("greedy/best_tour", n, [&] { sink += bestGreedyTour(matrix)[n - 1]; });
+        run("moves/swap_scan", n, [&] {
+            int best = INT_MAX;
+            for (int i = 0; i < n - 1; i++) {
+                for (int j = i + 1; j < n; j++) {
+                    best = min(best, swapDelta(matrix, permutation, i, j));
+                }
+            }
+            sink += best;
+        });
+        if (selected("moves/or3opt_scan")) {
+            const Neighborhood neighborhood(matrix, NeighborhoodKind::Or3Opt);
+            vector<int> position;
+            Neighborhood::indexPositions(permutation, position);
+            run("moves/or3opt_scan", n, [&] {
+                int best = INT_MAX;
+                neighborhood.forEachMove(permutation, position, [&](const Move& move) { best = min(best, move.delta); });
+                sink += best;
+            });
+        }
+    }
+
+    // Jeden krok wyżarzania: losowy ruch, kryterium Metropolisa i ewentualne wykonanie,
+    // w temperaturze początkowej SA (estimateInitialTemperature).
+    void annealing(const Adjacency_Matrix& graph) {
+        const int n = graph.getNumVertices();
+        const MatrixView matrix = graph.getView();
+        Random rng(INSTANCE_SEED);
+        const double inverseTemperature = 1.0 / estimateInitialTemperature(matrix, rng);
+        const NeighborhoodKind kinds[] = {NeighborhoodKind::FullSwap, NeighborhoodKind::Or3Opt};
+        const char* names[] = {"sa/move_accept_swap", "sa/move_accept_or3opt"};
+        for (int k = 0; k < 2; k++) {
+            if (!selected(names[k])) {
+                continue;
+            }
+            const Neighborhood neighborhood(matrix, kinds[k]);
+            vector<int> path = fixedPermutation(n);
+            vector<int> position;
+            Neighborhood::indexPositions(path, position);
+            int cost = tourCost(matrix, path);
+            run(names[k], n, [&] {
+                Move move = neighborhood.randomMove(path, position, rng);
+                if (metropolisAccept(move.delta, inverseTemperature, rng)) {
+                    Neighborhood::apply(move, path, position);
+                    cost += move.delta;
+                }
+            });
+            sink += cost;
+        }
+    }
+};
+
+// Wczytuje poprzednie wyniki: klucz "nazwa/n" -> ns na operację.
+map<string, double> readBaseline(const string& filename) {
+    map<string, double> baseline;
+    ifstream file(filename);
+    string line;
+    getline(file, line); // Nagłówek.
+    while (getline(file, line)) {
+        stringstream stream(line);
+        string name, n, iterations, nanos;
+        if (getline(stream, name, ',') && getline(stream, n, ',') && getline(stream, iterations, ',')
+            && getline(stream, nanos, ',')) {
+            baseline[name + "/" + n] = atof(nanos.c_str());
+        }
+    }
+    return baseline;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    vector<BenchmarkResult> results;
+    KernelBenchmarks benchmarks{options, results};
+    printf("%-24s %6s %14s %12s%s\n", "benchmark", "n", "ns/op", "iterations", ALLOCATION_COUNTING ? "  allocs/op" : "");
+    for (int n : options.sizes) {
+        benchmarks.instance(n);
+        Adjacency_Matrix graph;
+        graph.generate(n, INSTANCE_SEED);
+        benchmarks.moves(graph);
+        benchmarks.annealing(graph);
+    }
+
+    if (!options.output.empty()) {
+        FILE* out = fopen(options.output.c_str(), "w");
+        if (out == nullptr) {
+            cerr << "Nie mozna otworzyc pliku wynikow: " << options.output << endl;
+            return 1;
+        }
+        fprintf(out, "benchmark,n,iterations,ns_per_op\n");
+        for (const BenchmarkResult& result : results) {
+            fprintf(out, "%s,%d,%lld,%.3f\n", result.name.c_str(), result.n, result.iterations, result.nanosPerOp);
+        }
+        fclose(out);
+    }
+
+    int status = 0;
+    if (!options.baseline.empty()) {
+        map<string, double> baseline = readBaseline(options.baseline);
+        printf("\n%-24s %6s %14s %14s %8s\n", "benchmark", "n", "baseline", "ns/op", "ratio");
+        for (const BenchmarkResult& result : results) {
+            auto previous = baseline.find(result.name + "/" + to_string(result.n));
+            if (previous == baseline.end() || previous->second <= 0) {
+                continue;
+            }
+            double ratio = result.nanosPerOp / previous->second;
+            bool regressed = ratio > 1.0 + options.tolerance;
+            printf("%-24s %6d %14.1f %14.1f %7.2fx%s\n", result.name.c_str(), result.n, previous->second,
+                   result.nanosPerOp, ratio, regressed ? "  REGRESJA" : "");
+            if (regressed) status = 2;
+        }
+    }
+    return status;
+}
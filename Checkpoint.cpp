@@ -0,0 +1,207 @@
+#include "Checkpoint.h"
+#include "Moves.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+template <typename T>
+std::string joinValues(const std::vector<T>& values) {
+    std::ostringstream text;
+    for (size_t i = 0; i < values.size(); i++) {
+        text << (i > 0 ? " " : "") << values[i];
+    }
+    return text.str();
+}
+
+template <typename T>
+bool splitValues(const std::string& text, std::vector<T>& values) {
+    std::istringstream stream(text);
+    values.clear();
+    T value;
+    while (stream >> value) {
+        values.push_back(value);
+    }
+    return stream.eof();
+}
+
+}
+
+void Checkpoint::putText(const std::string& key, const std::string& value) {
+    entries[key] = value;
+}
+
+void Checkpoint::putInt(const std::string& key, long long value) {
+    entries[key] = std::to_string(value);
+}
+
+void Checkpoint::putReal(const std::string& key, double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.17g", value);
+    entries[key] = text;
+}
+
+void Checkpoint::putList(const std::string& key, const std::vector<int>& values) {
+    entries[key] = joinValues(values);
+}
+
+void Checkpoint::putWords(const std::string& key, const std::vector<uint64_t>& values) {
+    entries[key] = joinValues(values);
+}
+
+bool Checkpoint::getText(const std::string& key, std::string& value) const {
+    auto entry = entries.find(key);
+    if (entry == entries.end()) {
+        return false;
+    }
+    value = entry->second;
+    return true;
+}
+
+bool Checkpoint::getInt(const std::string& key, long long& value) const {
+    std::string text;
+    return getText(key, text) && std::sscanf(text.c_str(), "%lld", &value) == 1;
+}
+
+bool Checkpoint::getReal(const std::string& key, double& value) const {
+    std::string text;
+    return getText(key, text) && std::sscanf(text.c_str(), "%lf", &value) == 1;
+}
+
+bool Checkpoint::getList(const std::string& key, std::vector<int>& values) const {
+    std::string text;
+    return getText(key, text) && splitValues(text, values);
+}
+
+bool Checkpoint::getWords(const std::string& key, std::vector<uint64_t>& values) const {
+    std::string text;
+    return getText(key, text) && splitValues(text, values);
+}
+
+bool Checkpoint::save(const std::string& path) const {
+    std::string contents = "# stan przebiegu Pea2Projekt\n";
+    for (const auto& entry : entries) {
+        contents += entry.first + " " + entry.second + "\n";
+    }
+    return writeFileAtomically(path, contents);
+}
+
+bool Checkpoint::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    entries.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        const size_t space = line.find(' ');
+        entries[line.substr(0, space)] = space == std::string::npos ? "" : line.substr(space + 1);
+    }
+    return true;
+}
+
+void Checkpoint::putCommon(const std::string& solver, int n, const Random& rng, const std::vector<int>& best,
+                           int bestCost, const std::vector<int>& current, long long evaluations) {
+    putText("solver", solver);
+    putInt("n", n);
+    uint64_t words[4];
+    rng.save(words);
+    putWords("rng", std::vector<uint64_t>(words, words + 4));
+    putInt("evaluations", evaluations);
+    putInt("best_cost", bestCost);
+    putList("best", best);
+    putList("current", current);
+}
+
+void Checkpoint::getCommon(Random& rng, std::vector<int>& best, std::vector<int>& current,
+                           long long& evaluations) const {
+    std::vector<uint64_t> words;
+    if (getWords("rng", words) && words.size() == 4) {
+        rng.restore(words.data());
+    }
+    getList("best", best);
+    getList("current", current);
+    getInt("evaluations", evaluations);
+}
+
+bool Checkpoint::loadFor(const std::string& path, const std::string& solver, const MatrixView& matrix) {
+    if (!load(path)) {
+        std::cerr << "Nie można otworzyć pliku stanu: " << path << std::endl;
+        return false;
+    }
+    std::string saved;
+    long long n = 0, cost = 0;
+    std::vector<int> best, current;
+    if (!getText("solver", saved) || saved != solver || !getInt("n", n) || n != matrix.n
+        || !getList("best", best) || !isTour(best, matrix.n) || !getList("current", current)
+        || !isTour(current, matrix.n) || !getInt("best_cost", cost) || cost != tourCost(matrix, best)) {
+        std::cerr << "Plik stanu nie pasuje do instancji lub algorytmu " << solver << ": " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool writeFileAtomically(const std::string& path, const std::string& contents) {
+    const std::string temporary = path + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = contents.empty() || std::fwrite(contents.data(), contents.size(), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+    // Na Windows rename nie nadpisuje istniejącego pliku - wtedy stary plik jest najpierw usuwany.
+    if (ok && std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(path.c_str());
+        ok = std::rename(temporary.c_str(), path.c_str()) == 0;
+    }
+    if (!ok) {
+        std::remove(temporary.c_str());
+    }
+    return ok;
+}
+
+bool writeTourFile(const std::string& path, const std::vector<int>& tour, int cost, double foundTime) {
+    std::ostringstream text;
+    for (int node : tour) {
+        text << node << " ";
+    }
+    text << "\n# koszt " << cost << "\n# czas " << foundTime << "\n";
+    return writeFileAtomically(path, text.str());
+}
+
+bool readTourFile(const std::string& path, std::vector<int>& tour) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    tour.clear();
+    int node;
+    while (file >> node) {
+        tour.push_back(node);
+    }
+    return true;
+}
+
+bool isTour(const std::vector<int>& tour, int n) {
+    if ((int)tour.size() != n) {
+        return false;
+    }
+    std::vector<char> seen(n, 0);
+    for (int node : tour) {
+        if (node < 0 || node >= n || seen[node]) {
+            return false;
+        }
+        seen[node] = 1;
+    }
+    return true;
+}
+
+std::string checkpointFile(const std::string& base, int worker, int workers) {
+    return workers > 1 ? base + "." + std::to_string(worker) : base;
+}
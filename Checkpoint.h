@@ -0,0 +1,62 @@
+#ifndef PEA2_CHECKPOINT_H
+#define PEA2_CHECKPOINT_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "DistanceMatrix.h"
+#include "Random.h"
+
+// Stan przebiegu solvera zapisywany do pliku tekstowego: jeden wpis na wiersz,
+// "klucz wartość [wartość ...]". Liczby rzeczywiste zapisywane są z 17 cyframi
+// znaczącymi, więc odczyt odtwarza je bit w bit. Kolejność wpisów nie ma znaczenia.
+class Checkpoint {
+public:
+    void putText(const std::string& key, const std::string& value);
+    void putInt(const std::string& key, long long value);
+    void putReal(const std::string& key, double value);
+    void putList(const std::string& key, const std::vector<int>& values);
+    void putWords(const std::string& key, const std::vector<uint64_t>& values);
+
+    // Zwracają false, jeśli wpisu nie ma albo nie da się go odczytać.
+    bool getText(const std::string& key, std::string& value) const;
+    bool getInt(const std::string& key, long long& value) const;
+    bool getReal(const std::string& key, double& value) const;
+    bool getList(const std::string& key, std::vector<int>& values) const;
+    bool getWords(const std::string& key, std::vector<uint64_t>& values) const;
+
+    bool save(const std::string& path) const; // Atomowo (writeFileAtomically).
+    bool load(const std::string& path);
+
+    // Część stanu wspólna dla TS i SA: rodzaj solvera, rozmiar instancji, generator liczb
+    // losowych, najlepsza i bieżąca trasa oraz licznik ocenionych ruchów.
+    void putCommon(const std::string& solver, int n, const Random& rng, const std::vector<int>& best, int bestCost,
+                   const std::vector<int>& current, long long evaluations);
+    // Odczyt tej części z pliku sprawdzonego przez loadFor(); brakujące wpisy nie zmieniają argumentów.
+    void getCommon(Random& rng, std::vector<int>& best, std::vector<int>& current, long long& evaluations) const;
+    // Wczytuje plik stanu i sprawdza, czy zapisał go solver tego rodzaju dla instancji tego
+    // rozmiaru, a zapisany koszt najlepszej trasy zgadza się z macierzą. Błąd wypisuje na stderr.
+    bool loadFor(const std::string& path, const std::string& solver, const MatrixView& matrix);
+private:
+    std::map<std::string, std::string> entries;
+};
+
+// Zapisuje plik przez plik tymczasowy (path + ".tmp") i rename, więc czytelnik widzi
+// zawsze starą albo nową zawartość w całości, nawet po przerwaniu programu.
+bool writeFileAtomically(const std::string& path, const std::string& contents);
+
+// Trasa w formacie wynikiSA.txt i wynikiTS.txt (wierzchołki oddzielone spacjami), po niej
+// komentarze z kosztem i czasem znalezienia. readTourFile czyta wierzchołki do pierwszego
+// komentarza, więc rozumie oba formaty.
+bool writeTourFile(const std::string& path, const std::vector<int>& tour, int cost, double foundTime);
+bool readTourFile(const std::string& path, std::vector<int>& tour);
+
+// Czy tour jest permutacją wierzchołków 0..n-1.
+bool isTour(const std::vector<int>& tour, int n);
+
+// Plik stanu wątku worker z workers: przy jednym wątku sama nazwa bazowa, w przeciwnym
+// razie nazwa bazowa z numerem wątku (base.0, base.1, ...).
+std::string checkpointFile(const std::string& base, int worker, int workers);
+
+#endif // PEA2_CHECKPOINT_H
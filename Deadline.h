@@ -0,0 +1,95 @@
+#ifndef PEA2_DEADLINE_H
+#define PEA2_DEADLINE_H
+
+#include <atomic>
+#include <chrono>
+
+// Limit czasu ściennego (steady_clock) wspólny dla solverów. expired() wołane w gorącej
+// pętli zwykle tylko zmniejsza licznik; zegar i flaga stopu są sprawdzane co K wywołań,
+// a K dobierane jest z mierzonego tempa tak, by sprawdzenie wypadało mniej więcej co
+// CHECK_PERIOD. Flaga stopu pozwala zatrzymać przebieg z innego wątku (np. watchdoga).
+class Deadline {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    explicit Deadline(double seconds, const std::atomic<bool>* stopFlag = nullptr)
+        : start(Clock::now()), stop(stopFlag) {
+        end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+        lastCheck = start;
+    }
+
+    // Wersja dla jednego wątku, amortyzowana; po upływie czasu zwraca już zawsze true.
+    bool expired() {
+        if (--countdown > 0) {
+            return false;
+        }
+        Clock::time_point now = Clock::now();
+        // Dopasowanie K: tyle wywołań, ile zmieści się w CHECK_PERIOD przy ostatnim tempie.
+        double period = std::chrono::duration<double>(now - lastCheck).count();
+        double scaled = period > 0 ? interval * (CHECK_PERIOD / period) : interval * 2.0;
+        if (scaled > interval * 2.0) scaled = interval * 2.0; // Łagodny wzrost po krótkich przerwach.
+        interval = scaled < 1 ? 1 : (scaled > MAX_INTERVAL ? MAX_INTERVAL : (long long)scaled);
+        countdown = interval;
+        lastCheck = now;
+        finished = finished || now >= end || stopRequested();
+        return finished;
+    }
+
+    // Bezpośrednie sprawdzenie zegara i flagi; bezpieczne przy wielu wątkach.
+    bool reached() const {
+        return Clock::now() >= end || stopRequested();
+    }
+
+    // Sekundy od startu (odczyt zegara).
+    double elapsed() const {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Sekundy od startu w chwili ostatniego sprawdzenia w expired(), bez odczytu zegara.
+    double lastElapsed() const {
+        return std::chrono::duration<double>(lastCheck - start).count();
+    }
+
+private:
+    static constexpr double CHECK_PERIOD = 0.001;
+    static constexpr long long MAX_INTERVAL = 1LL << 24;
+
+    Clock::time_point start;
+    Clock::time_point end;
+    Clock::time_point lastCheck;
+    const std::atomic<bool>* stop;
+    long long interval = 1;
+    long long countdown = 1;
+    bool finished = false;
+
+    bool stopRequested() const {
+        return stop != nullptr && stop->load(std::memory_order_relaxed);
+    }
+};
+
+// Zdarzenie powtarzane co interval sekund przebiegu (zapis stanu, migracja, migawka).
+// Kolejne terminy idą stałym krokiem; po dłuższej przerwie zaległe terminy są pomijane.
+// Odstęp <= 0 wyłącza zdarzenie.
+class PeriodicTimer {
+public:
+    explicit PeriodicTimer(double interval) : interval(interval), next(interval) {
+    }
+
+    // Zwraca true, jeśli w chwili elapsed (sekundy od startu) minął kolejny termin.
+    bool due(double elapsed) {
+        if (interval <= 0 || elapsed < next) {
+            return false;
+        }
+        next += interval;
+        if (next <= elapsed) {
+            next = elapsed + interval;
+        }
+        return true;
+    }
+
+private:
+    double interval;
+    double next;
+};
+
+#endif // PEA2_DEADLINE_H
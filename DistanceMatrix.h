@@ -0,0 +1,57 @@
+#ifndef PEA2_DISTANCE_MATRIX_H
+#define PEA2_DISTANCE_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// Szerokość elementu macierzy wybierana przy kompilacji (opcja PEA_WEIGHT_INT16 w CMake).
+// Wagi 16-bitowe mieszczą macierze kilku tysięcy miast w pamięci podręcznej L2/L3.
+#ifdef PEA_WEIGHT_INT16
+typedef int16_t Weight;
+#else
+typedef int32_t Weight;
+#endif
+
+const int WEIGHT_MAX = std::numeric_limits<Weight>::max();
+const int MATRIX_ALIGNMENT = 64; // Wyrównanie bufora i początku każdego wiersza (linia cache).
+
+// Czy waga mieści się w zakresie typu Weight. Wagi spoza przekątnej, które się nie mieszczą,
+// są błędem wczytywania - przycięcie zmieniłoby instancję (np. przy PEA_WEIGHT_INT16).
+inline bool fitsWeight(long long value) {
+    return value >= std::numeric_limits<Weight>::min() && value <= WEIGHT_MAX;
+}
+
+// Przycina wagę do zakresu typu Weight. Przeznaczone dla wartownika na przekątnej
+// (np. 100000000 w plikach ATSP); pozostałe wagi trzeba najpierw sprawdzić fitsWeight().
+inline Weight clampWeight(long long value) {
+    if (value > WEIGHT_MAX) return (Weight)WEIGHT_MAX;
+    if (value < std::numeric_limits<Weight>::min()) return std::numeric_limits<Weight>::min();
+    return (Weight)value;
+}
+
+// Długość wiersza zaokrąglona w górę tak, aby każdy wiersz zaczynał się na granicy 64 bajtów.
+inline int paddedStride(int n) {
+    const int perLine = MATRIX_ALIGNMENT / (int)sizeof(Weight);
+    return (n + perLine - 1) / perLine * perLine;
+}
+
+// Lekki, niewłaścicielski widok na macierz odległości zapisaną wierszami w jednym buforze.
+// Nie kopiuje danych - właściciel bufora (Adjacency_Matrix) musi żyć dłużej niż widok.
+struct MatrixView {
+    const Weight* data = nullptr;
+    int n = 0;      // Liczba wierzchołków.
+    int stride = 0; // Odstęp między początkami kolejnych wierszy (w elementach).
+
+    int operator()(int from, int to) const {
+        return data[(size_t)from * stride + to];
+    }
+    const Weight* row(int from) const {
+        return data + (size_t)from * stride;
+    }
+    int size() const {
+        return n;
+    }
+};
+
+#endif // PEA2_DISTANCE_MATRIX_H
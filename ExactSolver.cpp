@@ -0,0 +1,453 @@
+#include "ExactSolver.h"
+#include "Greedy.h"
+#include "LocalSearch.h"
+#include "Moves.h"
+
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+namespace {
+
+// "Nieskończoność" Held-Karpa: suma dwóch takich wartości mieści się jeszcze w int, więc
+// minimum po poprzednikach liczy się bez rozgałęzień także dla stanów nieosiągalnych.
+const int UNREACHABLE = (1 << 30) - 1;
+
+// Koszt łuku zakazanego w problemie przydziału (przekątna i wykluczenia). Przydział
+// o koszcie co najmniej FORBIDDEN nie istnieje bez zakazanych łuków - węzeł odpada.
+const long long FORBIDDEN = 1LL << 40;
+
+}
+
+ExactSolver::ExactSolver(const Adjacency_Matrix& graph, double time) {
+    matrix = graph.getView(); // Widok na macierz sąsiedztwa grafu (bez kopiowania).
+    size = matrix.size();
+    timeBound = time;
+}
+
+ExactSolver::~ExactSolver() {
+}
+
+// Uruchamia solver i wypisuje wynik.
+void ExactSolver::apply() {
+    Tour result = solve();
+    std::ofstream file("wynikiExact.txt");
+    std::cout << "Droga: ";
+    for (int d = 0; d < size; d++) {
+        std::cout << result.path[d] << " ";
+        file << result.path[d] << " "; // Zapis do pliku.
+    }
+    std::cout << "\nKoszt: " << result.cost << std::endl;
+    std::cout << "Znaleziono po: " << result.foundTime << " s " << std::endl;
+    if (optimal) {
+        std::cout << "Optimum udowodnione" << std::endl;
+    } else {
+        std::cout << "Brak dowodu optymalnosci, dolne ograniczenie: " << bound << std::endl;
+    }
+}
+
+void ExactSolver::setThreads(int threads) {
+    pool.reset(threads > 1 ? new WorkerPool(threads) : nullptr);
+}
+
+void ExactSolver::setMethod(ExactMethod exact) {
+    method = exact;
+}
+
+// Held-Karp dla małych instancji, podział i ograniczenia dla pozostałych. Jeśli czas minie
+// przed dowodem, wynikiem jest najlepsza znana trasa (co najmniej trasa heurystyczna).
+Tour ExactSolver::solve(const SearchContext& context) {
+    Deadline deadline(timeBound, context.stop);
+    stats = SolverStats();
+    optimal = false;
+    bound = 0;
+    Tour result;
+    const bool dynamic = method != ExactMethod::BranchAndBound && size <= HELD_KARP_LIMIT;
+    if (dynamic) {
+        result = heldKarp(deadline);
+    }
+    if (result.path.empty()) {
+        result = heuristicTour();
+        result.foundTime = deadline.elapsed();
+        stats.improved(result.foundTime, result.cost);
+        if (context.globalBest != nullptr) {
+            context.globalBest->offer(result.path, result.cost, result.foundTime);
+        }
+        if (!dynamic) {
+            result = branchAndBound(deadline, result, context);
+        }
+    }
+    if (context.globalBest != nullptr) {
+        context.globalBest->offer(result.path, result.cost, result.foundTime);
+    }
+    if (TELEMETRY_ENABLED && context.telemetry != nullptr) {
+        stats.evaluations = result.evaluations;
+        context.telemetry->finish("exact", context.island, deadline.elapsed(), stats, result.cost);
+    }
+    return result;
+}
+
+// Trasa odniesienia: najlepsza trasa zachłanna z przeszukiwaniem lokalnym.
+Tour ExactSolver::heuristicTour() const {
+    Tour tour;
+    tour.path = bestGreedyTour(matrix, pool.get());
+    tour.cost = tourCost(matrix, tour.path);
+    if (size >= 5) {
+        LocalSearch search(matrix, std::make_shared<const CandidateLists>(matrix, 10));
+        search.improve(tour.path, tour.cost);
+    }
+    return tour;
+}
+
+// Wierzchołek 0 jest początkiem trasy, a pozostałe m = n - 1 wierzchołków (v -> v + 1)
+// tworzy maski. dp[S * m + v] to najkrótsza ścieżka z 0 przez wszystkie wierzchołki S
+// kończąca się w v (v należy do S); wiersz maski jest ciągły, a wagi trzymane są w kopii
+// transponowanej, więc minimum po poprzednikach to jedna pętla po dwóch ciągłych tablicach.
+Tour ExactSolver::heldKarp(Deadline& deadline) {
+    Tour result;
+    const int m = size - 1;
+    if (m <= 0) {
+        result.path.assign(size, 0);
+        result.cost = size > 0 ? tourCost(matrix, result.path) : 0;
+        optimal = true;
+        bound = result.cost;
+        return result;
+    }
+    const int full = (1 << m) - 1;
+    std::vector<int> into((size_t)m * m); // into[v * m + u] - waga łuku u -> v.
+    for (int v = 0; v < m; v++) {
+        for (int u = 0; u < m; u++) {
+            into[(size_t)v * m + u] = u == v ? UNREACHABLE : std::min(matrix(u + 1, v + 1), UNREACHABLE);
+        }
+    }
+    std::vector<int> dp((size_t)(full + 1) * m, UNREACHABLE);
+    for (int v = 0; v < m; v++) {
+        dp[(size_t)(1 << v) * m + v] = std::min(matrix(0, v + 1), UNREACHABLE);
+    }
+
+    // Warstwa k: maski o k bitach. Zadania dostają równe przedziały masek i pomijają
+    // maski z innych warstw - tańsze niż ich wyliczanie, bo stan kosztuje m dodawań.
+    const int tasks = pool != nullptr ? 4 * pool->size() : 1;
+    const int span = (full + tasks) / tasks;
+    int layer = 0;
+    const std::function<void(int)> fill = [&](int task) {
+        const int last = std::min(full, task * span + span - 1);
+        for (int set = task * span; set <= last; set++) {
+            if (__builtin_popcount(set) != layer) {
+                continue;
+            }
+            int* state = dp.data() + (size_t)set * m;
+            for (int rest = set; rest != 0; rest &= rest - 1) {
+                const int v = __builtin_ctz(rest);
+                const int* previous = dp.data() + (size_t)(set ^ (1 << v)) * m;
+                const int* weight = into.data() + (size_t)v * m;
+                int best = UNREACHABLE;
+                for (int u = 0; u < m; u++) {
+                    best = std::min(best, previous[u] + weight[u]);
+                }
+                state[v] = std::min(best, UNREACHABLE);
+            }
+        }
+    };
+    for (layer = 2; layer <= m; layer++) {
+        if (deadline.reached()) {
+            return result; // Pusta trasa - brak wyniku w limicie czasu.
+        }
+        if (pool != nullptr) {
+            pool->run(tasks, fill);
+        } else {
+            fill(0);
+        }
+    }
+    const long long states = (long long)m << (m - 1); // Stany (S, v) z v w S.
+    stats.iterations = states;
+    result.evaluations = states * m;
+
+    // Domknięcie cyklu i odtworzenie trasy od końca: poprzednik u to ten, przez który
+    // osiągnięto wartość dp[S][v].
+    int last = 0;
+    long long best = LLONG_MAX;
+    for (int v = 0; v < m; v++) {
+        const long long closed = (long long)dp[(size_t)full * m + v] + std::min(matrix(v + 1, 0), UNREACHABLE);
+        if (closed < best) {
+            best = closed;
+            last = v;
+        }
+    }
+    result.path.resize(size);
+    result.path[0] = 0;
+    int set = full;
+    for (int position = m; position >= 1; position--) {
+        result.path[position] = last + 1;
+        const int previousSet = set ^ (1 << last);
+        if (previousSet == 0) {
+            break;
+        }
+        const int* previous = dp.data() + (size_t)previousSet * m;
+        const int* weight = into.data() + (size_t)last * m;
+        const int target = dp[(size_t)set * m + last];
+        int u = 0;
+        while (u < m && (!(previousSet >> u & 1) || previous[u] + weight[u] != target)) {
+            u++;
+        }
+        set = previousSet;
+        last = u;
+    }
+    result.cost = tourCost(matrix, result.path);
+    result.foundTime = deadline.elapsed();
+    stats.improved(result.foundTime, result.cost);
+    optimal = true;
+    bound = result.cost;
+    return result;
+}
+
+// Ustawia fixed[u] = v dla łuków u -> v wymuszonych w węźle (pozostałe -1).
+void ExactSolver::collectFixed(int last) {
+    std::fill(fixed.begin(), fixed.end(), -1);
+    for (int c = last; c >= 0; c = constraints[c].previous) {
+        if (constraints[c].include) {
+            fixed[constraints[c].from] = constraints[c].to;
+        }
+    }
+}
+
+// Problem przydziału węzła o ograniczeniach kończących się na last. Łuk wymuszony u -> v
+// zakazuje pozostałych łuków z u i do v. Przydział trafia do successor.
+long long ExactSolver::evaluate(int last) {
+    const int n = size;
+    std::copy(base.begin(), base.end(), cost.begin());
+    collectFixed(last);
+    for (int c = last; c >= 0; c = constraints[c].previous) {
+        if (!constraints[c].include) {
+            cost[(size_t)constraints[c].from * n + constraints[c].to] = FORBIDDEN;
+        }
+    }
+    for (int u = 0; u < n; u++) {
+        const int v = fixed[u];
+        if (v < 0) {
+            continue;
+        }
+        for (int j = 0; j < n; j++) {
+            if (j != v) cost[(size_t)u * n + j] = FORBIDDEN;
+            if (j != u) cost[(size_t)j * n + v] = FORBIDDEN;
+        }
+    }
+    stats.evaluations++;
+    return hungarian();
+}
+
+// Metoda węgierska z potencjałami, O(n^3): wiersze dokładane po jednym, każdy najkrótszą
+// ścieżką powiększającą w grafie kosztów zredukowanych. Indeksy od 1, kolumna 0 to wartownik.
+long long ExactSolver::hungarian() {
+    const int n = size;
+    const long long infinity = LLONG_MAX / 4;
+    std::fill(rowPotential.begin(), rowPotential.end(), 0);
+    std::fill(columnPotential.begin(), columnPotential.end(), 0);
+    std::fill(assigned.begin(), assigned.end(), 0);
+    for (int row = 1; row <= n; row++) {
+        assigned[0] = row;
+        int column = 0;
+        std::fill(slack.begin(), slack.end(), infinity);
+        std::fill(used.begin(), used.end(), 0);
+        do {
+            used[column] = 1;
+            const int current = assigned[column];
+            const long long* weights = cost.data() + (size_t)(current - 1) * n - 1;
+            long long delta = infinity;
+            int next = 0;
+            for (int j = 1; j <= n; j++) {
+                if (used[j]) {
+                    continue;
+                }
+                const long long reduced = weights[j] - rowPotential[current] - columnPotential[j];
+                if (reduced < slack[j]) {
+                    slack[j] = reduced;
+                    way[j] = column;
+                }
+                if (slack[j] < delta) {
+                    delta = slack[j];
+                    next = j;
+                }
+            }
+            for (int j = 0; j <= n; j++) {
+                if (used[j]) {
+                    rowPotential[assigned[j]] += delta;
+                    columnPotential[j] -= delta;
+                } else {
+                    slack[j] -= delta;
+                }
+            }
+            column = next;
+        } while (assigned[column] != 0);
+        do {
+            const int previous = way[column];
+            assigned[column] = assigned[previous];
+            column = previous;
+        } while (column != 0);
+    }
+    long long total = 0;
+    for (int j = 1; j <= n; j++) {
+        successor[assigned[j] - 1] = j - 1;
+        total += cost[(size_t)(assigned[j] - 1) * n + j - 1];
+    }
+    return total;
+}
+
+// Przeszukiwanie w głąb z dolnym ograniczeniem z przydziału. Przydział będący jednym
+// cyklem jest trasą; w przeciwnym razie wybierany jest podcykl o najmniejszej liczbie
+// niewymuszonych łuków a_1..a_k i powstaje k dzieci: dziecko i wyklucza a_i i wymusza
+// a_1..a_(i-1), więc dzieci dzielą zbiór tras bez powtórzeń. Dzieci trafiają na stos
+// od najgorszego ograniczenia, więc jako pierwsze rozwijane jest najbardziej obiecujące.
+Tour ExactSolver::branchAndBound(Deadline& deadline, Tour incumbent, const SearchContext& context) {
+    const int n = size;
+    base.resize((size_t)n * n);
+    cost.resize(base.size());
+    for (int u = 0; u < n; u++) {
+        for (int v = 0; v < n; v++) {
+            base[(size_t)u * n + v] = u == v ? FORBIDDEN : matrix(u, v);
+        }
+    }
+    rowPotential.resize(n + 1);
+    columnPotential.resize(n + 1);
+    slack.resize(n + 1);
+    assigned.resize(n + 1);
+    way.resize(n + 1);
+    used.resize(n + 1);
+    successor.resize(n);
+    fixed.resize(n);
+    visited.resize(n);
+    freeArcs.reserve(n);
+    constraints.clear();
+    open.clear();
+    solutions.clear();
+
+    // Przydział o jednym cyklu poprawiający najlepszą trasę staje się nową trasą odniesienia.
+    auto offerTour = [&](long long value) {
+        int length = 1;
+        for (int v = successor[0]; v != 0 && length <= n; v = successor[v]) {
+            length++;
+        }
+        if (length != n) {
+            return false;
+        }
+        if (value < incumbent.cost) {
+            for (int i = 0, v = 0; i < n; i++, v = successor[v]) {
+                incumbent.path[i] = v;
+            }
+            incumbent.cost = (int)value;
+            incumbent.foundTime = deadline.elapsed();
+            stats.improved(incumbent.foundTime, incumbent.cost);
+            if (context.globalBest != nullptr) {
+                context.globalBest->offer(incumbent.path, incumbent.cost, incumbent.foundTime);
+            }
+        }
+        return true;
+    };
+    auto push = [&](long long value, int last) {
+        open.push_back(Node{value, last});
+        solutions.insert(solutions.end(), successor.begin(), successor.end());
+    };
+
+    const long long root = evaluate(-1);
+    if (root < incumbent.cost && !offerTour(root)) {
+        push(root, -1);
+    }
+    PeriodicTimer snapshotTimer(context.telemetry != nullptr ? context.telemetry->interval() : 0); // Migawki.
+    bool interrupted = false;
+    while (!open.empty()) {
+        if (deadline.expired() || context.budgetSpent(stats.evaluations)) {
+            interrupted = true;
+            break;
+        }
+        const Node node = open.back();
+        std::copy(solutions.end() - n, solutions.end(), successor.begin());
+        open.pop_back();
+        solutions.resize(solutions.size() - n);
+        if (node.bound >= incumbent.cost) {
+            continue;
+        }
+        stats.iterations++;
+        // Ograniczenia za ostatnim używanym przez stos lub ten węzeł są już niepotrzebne.
+        int keep = node.last;
+        for (const Node& waiting : open) {
+            keep = std::max(keep, waiting.last);
+        }
+        constraints.resize(keep + 1);
+
+        // Podcykl o najmniejszej liczbie łuków niewymuszonych.
+        collectFixed(node.last);
+        std::fill(visited.begin(), visited.end(), 0);
+        int chosen = -1, chosenFree = INT_MAX;
+        for (int start = 0; start < n; start++) {
+            if (visited[start]) {
+                continue;
+            }
+            int free = 0;
+            int v = start;
+            do {
+                visited[v] = 1;
+                free += fixed[v] != successor[v];
+                v = successor[v];
+            } while (v != start);
+            if (free < chosenFree) {
+                chosenFree = free;
+                chosen = start;
+            }
+        }
+        freeArcs.clear();
+        int v = chosen;
+        do {
+            if (fixed[v] != successor[v]) {
+                freeArcs.push_back(v);
+            }
+            v = successor[v];
+        } while (v != chosen);
+        // Łuki a_i = from -> successor[from] zapisane są jako wierzchołki from; successor
+        // zostanie nadpisany przez przydziały dzieci, więc końce łuków trzeba zapamiętać.
+        for (int& from : freeArcs) {
+            from = from * n + successor[from];
+        }
+
+        const size_t firstChild = open.size();
+        int included = node.last;
+        for (int arc : freeArcs) {
+            const int from = arc / n, to = arc % n;
+            constraints.push_back(Constraint{from, to, false, included});
+            const int excluded = (int)constraints.size() - 1;
+            const long long value = evaluate(excluded);
+            if (value < incumbent.cost && value < FORBIDDEN && !offerTour(value)) {
+                push(value, excluded);
+            }
+            constraints.push_back(Constraint{from, to, true, included});
+            included = (int)constraints.size() - 1;
+        }
+        // Sortowanie dzieci malejąco ograniczeniem razem z ich przydziałami.
+        for (size_t i = firstChild; i < open.size(); i++) {
+            size_t worst = i;
+            for (size_t j = i + 1; j < open.size(); j++) {
+                if (open[j].bound > open[worst].bound) worst = j;
+            }
+            if (worst != i) {
+                std::swap(open[i], open[worst]);
+                std::swap_ranges(solutions.begin() + i * n, solutions.begin() + (i + 1) * n, solutions.begin() + worst * n);
+            }
+        }
+
+        if (TELEMETRY_ENABLED && context.telemetry != nullptr && snapshotTimer.due(deadline.lastElapsed())) {
+            context.telemetry->snapshot("exact", context.island, deadline.lastElapsed(), stats,
+                                        (int)std::min<long long>(node.bound, INT_MAX), incumbent.cost);
+        }
+    }
+    // Po przerwaniu dolnym ograniczeniem jest najmniejsze ograniczenie węzłów, które
+    // zostały na stosie (poddrzewa już rozwinięte nie kryją tras tańszych od najlepszej).
+    long long lowest = incumbent.cost;
+    for (const Node& waiting : open) {
+        lowest = std::min(lowest, waiting.bound);
+    }
+    optimal = !interrupted;
+    bound = std::max(root, lowest);
+    incumbent.evaluations = stats.evaluations;
+    return incumbent;
+}
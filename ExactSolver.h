@@ -0,0 +1,80 @@
+#ifndef PEA2_EXACT_SOLVER_H
+#define PEA2_EXACT_SOLVER_H
+
+#include "adjacency_matrix.h"
+#include "Deadline.h"
+#include "SearchContext.h"
+#include "WorkerPool.h"
+#include <memory>
+#include <vector>
+
+// Największe n, dla którego tryb Auto wybiera Held-Karpa: tablica 2^(n-1) * (n-1) liczb
+// 32-bitowych zajmuje przy n = 20 ok. 40 MB, a każde kolejne miasto ją podwaja.
+const int HELD_KARP_LIMIT = 20;
+
+enum class ExactMethod {
+    Auto,           // Held-Karp do HELD_KARP_LIMIT miast, powyżej podział i ograniczenia.
+    HeldKarp,       // Programowanie dynamiczne (powyżej HELD_KARP_LIMIT jak BranchAndBound).
+    BranchAndBound, // Podział i ograniczenia z dolnym ograniczeniem z problemu przydziału.
+};
+
+// Dokładny solver dla małych instancji. Held-Karp wypełnia dp[S][v] - najkrótszą ścieżkę
+// z wierzchołka 0 przez zbiór S kończącą się w v - warstwami według |S|; stany jednej
+// warstwy zależą tylko od poprzedniej, więc warstwa dzielona jest między wątki puli.
+// Podział i ograniczenia (schemat Carpaneto-Totha dla ATSP) w każdym węźle rozwiązuje
+// problem przydziału metodą węgierską; gdy przydział rozpada się na podcykle, dzieli
+// węzeł na wykluczenia łuków najkrótszego z nich. Pierwszą trasą odniesienia jest trasa
+// zachłanna poprawiona przeszukiwaniem lokalnym. Po upływie czasu wynikiem jest najlepsza
+// znaleziona trasa, a proven() mówi, czy jej optymalność została udowodniona.
+class ExactSolver {
+public:
+    ExactSolver(const Adjacency_Matrix& graph, double time);
+    ~ExactSolver();
+    void apply();
+    Tour solve(const SearchContext& context = SearchContext()); // Przebieg bez wypisywania wyników.
+    void setThreads(int threads); // Wątki wypełniające warstwy Held-Karpa (domyślnie 1).
+    void setMethod(ExactMethod method);
+    bool proven() const { return optimal; } // Koszt ostatniego wyniku jest optimum.
+    long long lowerBound() const { return bound; } // Udowodnione dolne ograniczenie optimum.
+    const SolverStats& statistics() const { return stats; }
+private:
+    // Ograniczenie nałożone w węźle drzewa podziału. Ograniczenia węzła tworzą listę
+    // od ostatniego do korzenia (previous), współdzieloną z rodzeństwem.
+    struct Constraint {
+        int from, to;
+        bool include;  // true - łuk musi należeć do trasy, false - jest wykluczony.
+        int previous;  // Poprzednie ograniczenie węzła (-1 - korzeń).
+    };
+    struct Node {
+        long long bound; // Koszt przydziału, dolne ograniczenie tras w poddrzewie.
+        int last;        // Ostatnie ograniczenie węzła w constraints (-1 - korzeń).
+    };
+
+    MatrixView matrix; // Widok na macierz grafu; graf musi żyć dłużej niż solver.
+    int size;
+    double timeBound;
+    ExactMethod method = ExactMethod::Auto;
+    std::unique_ptr<WorkerPool> pool;
+    bool optimal = false;
+    long long bound = 0;
+    SolverStats stats;
+
+    // Stan podziału i ograniczeń, przydzielany raz na przebieg.
+    std::vector<Constraint> constraints;
+    std::vector<Node> open;            // Stos węzłów do rozwinięcia (przeszukiwanie w głąb).
+    std::vector<long long> base;       // Wagi z zakazaną przekątną (n x n).
+    std::vector<long long> cost;       // Macierz przydziału węzła: base z ograniczeniami węzła.
+    std::vector<long long> rowPotential, columnPotential, slack;
+    std::vector<int> solutions;        // Przydział węzła open[i] w [i * n, (i + 1) * n).
+    std::vector<int> assigned, way, successor, fixed, visited, freeArcs;
+    std::vector<char> used;
+
+    Tour heldKarp(Deadline& deadline);
+    Tour branchAndBound(Deadline& deadline, Tour incumbent, const SearchContext& context);
+    Tour heuristicTour() const;
+    void collectFixed(int last);
+    long long evaluate(int last);
+    long long hungarian();
+};
+
+#endif // PEA2_EXACT_SOLVER_H
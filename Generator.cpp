@@ -0,0 +1,104 @@
+#include "Generator.h"
+#include "InstanceCache.h"
+#include "Random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <new>
+
+namespace {
+
+// Wiersze liczone naraz przy zapisie strumieniowym: blok ok. BLOCK_BYTES, ale co najmniej
+// jeden wiersz na zadanie puli.
+const size_t BLOCK_BYTES = 64 << 20;
+
+const double TWO_PI = 6.283185307179586;
+
+}
+
+// Współrzędne losowane są raz, jednym strumieniem z ziarna: O(n) czasu i pamięci.
+InstanceGenerator::InstanceGenerator(const GeneratorOptions& settings) : options(settings) {
+    Random rng(options.seed);
+    key = rng();
+    const int n = options.size;
+    if (options.family == InstanceFamily::Uniform) {
+        return;
+    }
+    x.resize(n);
+    y.resize(n);
+    if (options.family == InstanceFamily::FtvLike) {
+        for (int i = 0; i < n; i++) {
+            x[i] = rng.uniform() * options.extent;
+            y[i] = rng.uniform() * options.extent;
+        }
+        return;
+    }
+    // Środki skupisk rozłożone równomiernie, punkty wokół nich z rozkładem normalnym
+    // (Box-Muller) o odchyleniu malejącym z liczbą skupisk, przycięte do kwadratu.
+    const int clusters = options.clusters > 0 ? options.clusters : std::max(1, n / 100);
+    std::vector<double> centerX(clusters), centerY(clusters);
+    for (int c = 0; c < clusters; c++) {
+        centerX[c] = rng.uniform() * options.extent;
+        centerY[c] = rng.uniform() * options.extent;
+    }
+    const double spread = options.extent / (4.0 * std::sqrt((double)clusters));
+    for (int i = 0; i < n; i++) {
+        const int c = rng.below(clusters);
+        const double radius = spread * std::sqrt(-2.0 * std::log(1.0 - rng.uniform()));
+        const double angle = TWO_PI * rng.uniform();
+        x[i] = std::min((double)options.extent, std::max(0.0, centerX[c] + radius * std::cos(angle)));
+        y[i] = std::min((double)options.extent, std::max(0.0, centerY[c] + radius * std::sin(angle)));
+    }
+}
+
+void InstanceGenerator::fillRow(int from, Weight* row) const {
+    for (int to = 0; to < options.size; to++) {
+        row[to] = (Weight)(*this)(from, to);
+    }
+}
+
+bool parseInstanceFamily(const std::string& name, InstanceFamily& family) {
+    if (name == "uniform") family = InstanceFamily::Uniform;
+    else if (name == "clustered") family = InstanceFamily::Clustered;
+    else if (name == "ftv") family = InstanceFamily::FtvLike;
+    else return false;
+    return true;
+}
+
+bool writeGeneratedInstance(const std::string& path, const InstanceGenerator& generator, WorkerPool* pool) {
+    const int n = generator.size();
+    const int stride = paddedStride(n);
+    const int tasks = pool != nullptr ? pool->size() : 1;
+    const int rowsPerBlock = std::max(tasks, (int)std::min<size_t>(n, BLOCK_BYTES / ((size_t)stride * sizeof(Weight))));
+    // Blok wyrównany jak bufor macierzy; dopełnienie wierszy wypełnione maksymalną wagą.
+    const size_t count = (size_t)rowsPerBlock * stride;
+    std::unique_ptr<Weight, void (*)(Weight*)> block(
+        static_cast<Weight*>(::operator new(std::max(count, (size_t)1) * sizeof(Weight), std::align_val_t(MATRIX_ALIGNMENT))),
+        [](Weight* p) { ::operator delete(p, std::align_val_t(MATRIX_ALIGNMENT)); });
+    std::fill(block.get(), block.get() + count, (Weight)WEIGHT_MAX);
+
+    InstanceWriter writer;
+    if (!writer.open(path, n)) {
+        return false;
+    }
+    int first = 0, rows = 0;
+    const std::function<void(int)> fill = [&](int task) {
+        for (int r = task; r < rows; r += tasks) {
+            generator.fillRow(first + r, block.get() + (size_t)r * stride);
+        }
+    };
+    for (first = 0; first < n; first += rows) {
+        rows = std::min(rowsPerBlock, n - first);
+        if (pool != nullptr) {
+            pool->run(tasks, fill);
+        } else {
+            fill(0);
+        }
+        if (!writer.writeRows(block.get(), rows)) {
+            return false;
+        }
+    }
+    return writer.close();
+}
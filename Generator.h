@@ -0,0 +1,77 @@
+#ifndef PEA2_GENERATOR_H
+#define PEA2_GENERATOR_H
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "DistanceMatrix.h"
+#include "WorkerPool.h"
+
+// Rodziny instancji syntetycznych.
+enum class InstanceFamily {
+    Uniform,   // ATSP o wagach 1..101 losowanych niezależnie dla każdego łuku.
+    Clustered, // Punkty w skupiskach na płaszczyźnie, wagi euklidesowe jak EUC_2D (symetryczne).
+    FtvLike,   // Odległości euklidesowe z asymetrycznym narzutem łuku, jak w instancjach ftv.
+};
+
+struct GeneratorOptions {
+    InstanceFamily family = InstanceFamily::Uniform;
+    int size = 0;
+    uint64_t seed = 1;
+    int clusters = 0;       // Clustered: liczba skupisk (0 - ok. n / 100, co najmniej 1).
+    int extent = 10000;     // Bok kwadratu, w którym losowane są punkty.
+    double asymmetry = 0.2; // FtvLike: największy względny narzut łuku (0.2 - do 20%).
+};
+
+// Generator instancji o stanie O(n). Waga d(i, j) jest deterministyczną funkcją ziarna,
+// współrzędnych punktów (Clustered, FtvLike) i skrótu pary (i, j) (Uniform, narzut FtvLike),
+// więc można ją liczyć na żądanie, w dowolnej kolejności i na wielu wątkach - wynik nie
+// zależy od podziału pracy. Interfejs (operator(), size()) jest taki jak w MatrixView.
+// Na przekątnej jest -1 (Uniform, jak w Adjacency_Matrix::generate) albo 0 (jak w EUC_2D).
+class InstanceGenerator {
+public:
+    explicit InstanceGenerator(const GeneratorOptions& options);
+    int size() const { return options.size; }
+    const GeneratorOptions& settings() const { return options; }
+
+    int operator()(int from, int to) const {
+        if (from == to) {
+            return options.family == InstanceFamily::Uniform ? -1 : 0;
+        }
+        if (options.family == InstanceFamily::Uniform) {
+            return 1 + (int)(pairHash(from, to) % 101);
+        }
+        const double dx = x[from] - x[to], dy = y[from] - y[to];
+        double distance = std::sqrt(dx * dx + dy * dy);
+        if (options.family == InstanceFamily::FtvLike) {
+            distance *= 1.0 + options.asymmetry * (pairHash(from, to) >> 11) * (1.0 / 9007199254740992.0);
+        }
+        return clampWeight((long long)(distance + 0.5));
+    }
+
+    void fillRow(int from, Weight* row) const; // n wag wiersza from.
+
+private:
+    GeneratorOptions options;
+    std::vector<double> x, y; // Współrzędne punktów (puste dla Uniform).
+    uint64_t key;             // Ziarno skrótu par.
+
+    // splitmix64 pary (from, to) zmieszanej z ziarnem; (i, j) i (j, i) dają różne wartości.
+    uint64_t pairHash(int from, int to) const {
+        uint64_t z = key + ((uint64_t)(uint32_t)from << 32 | (uint32_t)to) * 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+};
+
+// Nazwa rodziny w specyfikacji instancji ("uniform", "clustered", "ftv").
+bool parseInstanceFamily(const std::string& name, InstanceFamily& family);
+
+// Zapisuje instancję w formacie binarnym (InstanceCache.h) strumieniowo: bloki wierszy
+// liczone są równolegle na puli (jeśli podano) i dopisywane do pliku, więc pamięć to
+// jeden blok, a nie cała macierz. Plik można potem wczytać (zmapować) jako instancję.
+bool writeGeneratedInstance(const std::string& path, const InstanceGenerator& generator, WorkerPool* pool = nullptr);
+
+#endif // PEA2_GENERATOR_H
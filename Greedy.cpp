@@ -0,0 +1,141 @@
+#include "Greedy.h"
+
+#include <algorithm>
+#include <climits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PEA_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace {
+
+int nearestScalar(const Weight* row, const int32_t* mask, int n) {
+    int bestValue = INT_MAX;
+    int nearest = -1;
+    for (int j = 0; j < n; j++) {
+        const int value = std::max((int32_t)row[j], mask[j]);
+        if (value < bestValue) {
+            bestValue = value;
+            nearest = j;
+        }
+    }
+    return nearest;
+}
+
+#ifdef PEA_AVX2_DISPATCH
+// Osiem niezależnych minimów (wartość i pierwszy indeks w każdej linii wektora), scalanych
+// na końcu z rozstrzyganiem remisów najmniejszym indeksem, jak w pętli skalarnej.
+__attribute__((target("avx2")))
+int nearestAvx2(const Weight* row, const int32_t* mask, int n) {
+    __m256i best = _mm256_set1_epi32(INT_MAX);
+    __m256i bestIndex = _mm256_set1_epi32(-1);
+    __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i step = _mm256_set1_epi32(8);
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+#ifdef PEA_WEIGHT_INT16
+        const __m256i weights = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(row + j)));
+#else
+        const __m256i weights = _mm256_loadu_si256((const __m256i*)(row + j));
+#endif
+        const __m256i value = _mm256_max_epi32(weights, _mm256_loadu_si256((const __m256i*)(mask + j)));
+        const __m256i less = _mm256_cmpgt_epi32(best, value);
+        best = _mm256_min_epi32(best, value);
+        bestIndex = _mm256_blendv_epi8(bestIndex, index, less);
+        index = _mm256_add_epi32(index, step);
+    }
+    alignas(32) int32_t values[8];
+    alignas(32) int32_t indices[8];
+    _mm256_store_si256((__m256i*)values, best);
+    _mm256_store_si256((__m256i*)indices, bestIndex);
+    int bestValue = INT_MAX;
+    int nearest = -1;
+    for (int lane = 0; lane < 8; lane++) {
+        if (indices[lane] >= 0 && (values[lane] < bestValue || (values[lane] == bestValue && indices[lane] < nearest))) {
+            bestValue = values[lane];
+            nearest = indices[lane];
+        }
+    }
+    for (; j < n; j++) {
+        const int value = std::max((int32_t)row[j], mask[j]);
+        if (value < bestValue) {
+            bestValue = value;
+            nearest = j;
+        }
+    }
+    return nearest;
+}
+#endif
+
+typedef int (*NearestKernel)(const Weight*, const int32_t*, int);
+
+// Wybór jądra przy pierwszym użyciu (statyczna zmienna lokalna - bezpieczna przy wielu wątkach).
+NearestKernel nearestKernel() {
+    static const NearestKernel kernel = [] {
+#ifdef PEA_AVX2_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return (NearestKernel)nearestAvx2;
+        }
+#endif
+        return (NearestKernel)nearestScalar;
+    }();
+    return kernel;
+}
+
+}
+
+int nearestUnvisited(const Weight* row, const int32_t* mask, int n) {
+    return nearestKernel()(row, mask, n);
+}
+
+std::vector<int> greedyTour(const MatrixView& matrix, int start, long long* cost) {
+    const int n = matrix.size();
+    std::vector<int> path;
+    path.reserve(n);
+    std::vector<int32_t> mask(n, UNVISITED);
+    const NearestKernel nearestOf = nearestKernel();
+    int current = start;
+    long long total = 0;
+    path.push_back(current);
+    mask[current] = VISITED;
+    for (int i = 1; i < n; i++) {
+        int nearest = nearestOf(matrix.row(current), mask.data(), n);
+        if (nearest < 0) {
+            // Wszystkie pozostałe wagi równe INT32_MAX - pierwszy nieodwiedzony.
+            nearest = (int)(std::find(mask.begin(), mask.end(), UNVISITED) - mask.begin());
+        }
+        total += matrix(current, nearest);
+        path.push_back(nearest);
+        mask[nearest] = VISITED;
+        current = nearest;
+    }
+    total += matrix(current, start); // Powrót do startu.
+    if (cost != nullptr) {
+        *cost = total;
+    }
+    return path;
+}
+
+std::vector<int> bestGreedyTour(const MatrixView& matrix, WorkerPool* pool, long long budget) {
+    const int n = matrix.size();
+    if (n == 0) {
+        return {};
+    }
+    const long long perStart = std::max(1LL, (long long)n * n);
+    const int starts = (int)std::max(1LL, std::min((long long)n, budget / perStart));
+    std::vector<std::vector<int>> tours(starts);
+    std::vector<long long> costs(starts);
+    auto build = [&](int s) {
+        tours[s] = greedyTour(matrix, (int)((long long)s * n / starts), &costs[s]);
+    };
+    if (pool != nullptr && starts > 1) {
+        pool->run(starts, build);
+    } else {
+        for (int s = 0; s < starts; s++) build(s);
+    }
+    // Przy remisie wygrywa wcześniejszy start, więc wynik nie zależy od liczby wątków.
+    int bestStart = (int)(std::min_element(costs.begin(), costs.end()) - costs.begin());
+    return std::move(tours[bestStart]);
+}
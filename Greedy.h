@@ -0,0 +1,32 @@
+#ifndef PEA2_GREEDY_H
+#define PEA2_GREEDY_H
+
+#include <cstdint>
+#include <vector>
+#include "DistanceMatrix.h"
+#include "WorkerPool.h"
+
+// Maska odwiedzin dla nearestUnvisited: wartość brana jest jako max(waga, maska), więc
+// UNVISITED przepuszcza wagę, a VISITED zastępuje ją wartownikiem nie mniejszym od żadnej wagi.
+const int32_t UNVISITED = INT32_MIN;
+const int32_t VISITED = INT32_MAX;
+
+// Łączna liczba elementów macierzy przeglądanych przez bestGreedyTour (kilkadziesiąt ms
+// przy AVX2): wszystkie starty do ok. 400 miast, jeden start powyżej ok. 8000.
+const long long GREEDY_BUDGET = 1LL << 26;
+
+// Indeks najmniejszej wagi w wierszu wśród wierzchołków z maską UNVISITED (przy remisie
+// najmniejszy indeks); -1, jeśli żaden nie ma wagi mniejszej od INT32_MAX. Jądro AVX2
+// wybierane jest w czasie działania, gdy procesor je obsługuje; w przeciwnym razie pętla skalarna.
+int nearestUnvisited(const Weight* row, const int32_t* mask, int n);
+
+// Trasa najbliższego sąsiada z wierzchołka start; cost (opcjonalnie) dostaje jej koszt.
+std::vector<int> greedyTour(const MatrixView& matrix, int start, long long* cost = nullptr);
+
+// Najlepsza z tras najbliższego sąsiada z wielu startów: ze wszystkich n wierzchołków, jeśli
+// mieszczą się w budżecie (n^2 na start), a inaczej z równomiernie rozłożonych startów
+// (zawsze co najmniej z wierzchołka 0). Starty budowane są równolegle na puli, jeśli podano.
+std::vector<int> bestGreedyTour(const MatrixView& matrix, WorkerPool* pool = nullptr,
+                                long long budget = GREEDY_BUDGET);
+
+#endif // PEA2_GREEDY_H
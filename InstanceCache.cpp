@@ -0,0 +1,186 @@
+#include "InstanceCache.h"
+#include "MappedFile.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char CACHE_MAGIC[8] = {'P', 'E', 'A', '2', 'B', 'I', 'N', '\0'};
+const uint32_t CACHE_VERSION = 1;
+
+// Plik tymczasowy unikalny dla procesu i zapisu: procesy budujące równocześnie ten sam cache
+// nie piszą do jednego pliku, a każdy podmienia cache kompletnym plikiem.
+std::string temporaryPath(const std::string& path) {
+    static std::atomic<unsigned> counter{0};
+#ifdef _WIN32
+    const long long process = _getpid();
+#else
+    const long long process = getpid();
+#endif
+    return path + ".tmp." + std::to_string(process) + "." + std::to_string(counter++);
+}
+
+// Nagłówek ma dokładnie 64 bajty, więc macierz za nim zaczyna się na granicy linii cache.
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t elementWidth;
+    uint32_t dimension;
+    uint32_t stride;
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    uint64_t checksum;
+    uint8_t reserved[16];
+};
+static_assert(sizeof(CacheHeader) == MATRIX_ALIGNMENT, "naglowek musi zajmowac jedna linie cache");
+
+const uint64_t CHECKSUM_SEED = 14695981039346656037ull;
+
+// FNV-1a liczone słowami 64-bitowymi; rozmiar macierzy jest zawsze wielokrotnością 64 bajtów.
+// Kolejne bloki można doliczać do wyniku poprzednich (hash), co daje to samo co jeden blok.
+uint64_t checksum(const void* data, size_t bytes, uint64_t hash = CHECKSUM_SEED) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i + 8 <= bytes; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, p + i, 8);
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Rozmiar i czas modyfikacji pliku źródłowego, po których rozpoznajemy jego zmianę.
+bool sourceStamp(const std::string& source, uint64_t& size, int64_t& time) {
+    std::error_code ec;
+    size = std::filesystem::file_size(source, ec);
+    if (ec) return false;
+    auto modified = std::filesystem::last_write_time(source, ec);
+    if (ec) return false;
+    time = (int64_t)modified.time_since_epoch().count();
+    return true;
+}
+
+// Mapuje plik binarny path; gdy podano source, sprawdza też, że kopia odpowiada temu plikowi.
+bool mapInstance(const std::string& path, const std::string* source, std::shared_ptr<const Weight>& storage,
+                 int& n, int& stride) {
+    uint64_t size = 0;
+    int64_t time = 0;
+    if (source != nullptr && !sourceStamp(*source, size, time)) {
+        return false;
+    }
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(path) || file->size() < sizeof(CacheHeader)) {
+        return false;
+    }
+    CacheHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION
+        || header.elementWidth != sizeof(Weight) || header.stride != (uint32_t)paddedStride((int)header.dimension)
+        || (source != nullptr && (header.sourceSize != size || header.sourceTime != time))) {
+        return false;
+    }
+    size_t bytes = (size_t)header.dimension * header.stride * sizeof(Weight);
+    const char* matrix = file->data() + sizeof(CacheHeader);
+    if (file->size() != sizeof(CacheHeader) + bytes || (uintptr_t)matrix % MATRIX_ALIGNMENT != 0
+        || checksum(matrix, bytes) != header.checksum) {
+        return false;
+    }
+    // Konstruktor aliasujący: wskaźnik na macierz, a własność nad całym mapowaniem.
+    storage = std::shared_ptr<const Weight>(file, reinterpret_cast<const Weight*>(matrix));
+    n = (int)header.dimension;
+    stride = (int)header.stride;
+    return true;
+}
+
+}
+
+std::string instanceCachePath(const std::string& source) {
+    return source + ".bin";
+}
+
+bool readInstanceCache(const std::string& source, std::shared_ptr<const Weight>& storage, int& n, int& stride) {
+    return mapInstance(instanceCachePath(source), &source, storage, n, stride);
+}
+
+bool readInstanceBinary(const std::string& path, std::shared_ptr<const Weight>& storage, int& n, int& stride) {
+    return mapInstance(path, nullptr, storage, n, stride);
+}
+
+bool writeInstanceCache(const std::string& source, const MatrixView& matrix) {
+    uint64_t size;
+    int64_t time;
+    if (!sourceStamp(source, size, time)) {
+        return false;
+    }
+    InstanceWriter writer;
+    return writer.open(instanceCachePath(source), matrix.n, size, time)
+           && writer.writeRows(matrix.data, matrix.n) && writer.close();
+}
+
+InstanceWriter::~InstanceWriter() {
+    if (file != nullptr) {
+        std::fclose(file);
+        std::remove(temporary.c_str());
+    }
+}
+
+// Zapis do pliku tymczasowego i zamiana nazwy w close(), aby inny proces nie zmapował połowy pliku.
+bool InstanceWriter::open(const std::string& path, int n, uint64_t sourceSize, int64_t sourceTime) {
+    target = path;
+    temporary = temporaryPath(path);
+    dimension = n;
+    written = 0;
+    hash = CHECKSUM_SEED;
+    stampSize = sourceSize;
+    stampTime = sourceTime;
+    file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    CacheHeader header = {}; // Suma kontrolna jeszcze nieznana - nagłówek jest nadpisywany w close().
+    return std::fwrite(&header, sizeof(header), 1, file) == 1;
+}
+
+bool InstanceWriter::writeRows(const Weight* rows, int count) {
+    if (file == nullptr || written + count > dimension) {
+        return false;
+    }
+    size_t bytes = (size_t)count * paddedStride(dimension) * sizeof(Weight);
+    hash = checksum(rows, bytes, hash);
+    written += count;
+    return bytes == 0 || std::fwrite(rows, bytes, 1, file) == 1;
+}
+
+bool InstanceWriter::close() {
+    if (file == nullptr) {
+        return false;
+    }
+    CacheHeader header = {};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.elementWidth = sizeof(Weight);
+    header.dimension = (uint32_t)dimension;
+    header.stride = (uint32_t)paddedStride(dimension);
+    header.sourceSize = stampSize;
+    header.sourceTime = stampTime;
+    header.checksum = hash;
+    bool ok = written == dimension && std::fseek(file, 0, SEEK_SET) == 0
+              && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    if (!ok || std::rename(temporary.c_str(), target.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
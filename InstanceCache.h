@@ -0,0 +1,53 @@
+#ifndef PEA2_INSTANCE_CACHE_H
+#define PEA2_INSTANCE_CACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include "DistanceMatrix.h"
+
+// Binarna kopia wczytanej instancji zapisywana obok pliku źródłowego (plik + ".bin").
+// Układ pliku: 64-bajtowy nagłówek (sygnatura, wersja, szerokość elementu, wymiar,
+// stride, rozmiar i czas modyfikacji źródła, suma kontrolna), a po nim surowa macierz
+// dokładnie w układzie bufora Adjacency_Matrix. Dzięki temu macierz jest używana
+// bezpośrednio ze zmapowanego pliku, bez kopiowania. Ten sam format mają samodzielne
+// pliki ".bin" z generatora instancji (rozmiar i czas źródła są w nich zerami).
+std::string instanceCachePath(const std::string& source);
+
+// Mapuje kopię binarną, jeśli istnieje, odpowiada niezmienionemu plikowi źródłowemu
+// i została zapisana z tą samą szerokością wagi. Bufor w storage trzyma mapowanie przy życiu.
+bool readInstanceCache(const std::string& source, std::shared_ptr<const Weight>& storage, int& n, int& stride);
+
+// Zapisuje kopię binarną macierzy dla danego pliku źródłowego.
+bool writeInstanceCache(const std::string& source, const MatrixView& matrix);
+
+// Mapuje samodzielny plik binarny (np. zapisany przez generator), bez pliku źródłowego.
+bool readInstanceBinary(const std::string& path, std::shared_ptr<const Weight>& storage, int& n, int& stride);
+
+// Strumieniowy zapis pliku binarnego: nagłówek, a po nim kolejne bloki wierszy (dopełnionych
+// do stride), więc cała macierz nie musi być naraz w pamięci. Suma kontrolna liczona jest
+// w trakcie zapisu i uzupełniana w nagłówku przez close(); do tego czasu plik ma nazwę
+// tymczasową. Obiekt zniszczony bez close() usuwa plik tymczasowy.
+class InstanceWriter {
+public:
+    InstanceWriter() = default;
+    ~InstanceWriter();
+    InstanceWriter(const InstanceWriter&) = delete;
+    InstanceWriter& operator=(const InstanceWriter&) = delete;
+
+    // sourceSize i sourceTime opisują plik źródłowy kopii (0 - plik samodzielny).
+    bool open(const std::string& path, int n, uint64_t sourceSize = 0, int64_t sourceTime = 0);
+    bool writeRows(const Weight* rows, int count); // count wierszy po stride wag.
+    bool close();
+private:
+    std::FILE* file = nullptr;
+    std::string target, temporary;
+    int dimension = 0;
+    int written = 0;
+    uint64_t hash = 0;
+    uint64_t stampSize = 0;
+    int64_t stampTime = 0;
+};
+
+#endif // PEA2_INSTANCE_CACHE_H
@@ -0,0 +1,73 @@
+#include "LocalSearch.h"
+
+LocalSearch::LocalSearch(const MatrixView& matrix, std::shared_ptr<const CandidateLists> lists)
+    : orOpt(matrix, NeighborhoodKind::OrOpt, lists), or3Opt(matrix, NeighborhoodKind::Or3Opt, lists) {
+}
+
+void LocalSearch::activate(int vertex) {
+    if (!queued[vertex]) {
+        queued[vertex] = 1;
+        const int tail = head + count;
+        active[tail >= (int)active.size() ? tail - (int)active.size() : tail] = vertex;
+        count++;
+    }
+}
+
+bool LocalSearch::improve(std::vector<int>& path, int& cost, Deadline* deadline) {
+    const int n = path.size();
+    if (n < 5) {
+        return false;
+    }
+    const int startCost = cost;
+    Neighborhood::indexPositions(path, position);
+    queued.assign(n, 0);
+    active.resize(n);
+    head = 0;
+    count = 0;
+    for (int v : path) {
+        activate(v);
+    }
+
+    while (count > 0) {
+        if (deadline != nullptr && deadline->expired()) {
+            break;
+        }
+        int v = active[head];
+        head = head + 1 == n ? 0 : head + 1;
+        count--;
+        queued[v] = 0;
+
+        // Najlepszy ruch poprawiający zaczepiony na pozycji v.
+        Move best;
+        auto consider = [&best](const Move& move) {
+            if (move.delta < best.delta) best = move;
+        };
+        orOpt.forEachMoveAt(position[v], path, position, consider);
+        or3Opt.forEachMoveAt(position[v], path, position, consider);
+        if (best.delta >= 0) {
+            continue; // Bit don't-look pozostaje ustawiony, dopóki sąsiedztwo v się nie zmieni.
+        }
+
+        // Końce usuniętych krawędzi tracą bit don't-look.
+        int ends[] = {best.a, best.a + 1, best.b, best.b + 1, best.c, (best.c + 1) % n};
+        for (int p : ends) {
+            activate(path[p]);
+        }
+        Neighborhood::apply(best, path, position);
+        cost += best.delta;
+        activate(v);
+    }
+    return cost < startCost;
+}
+
+bool LocalSearch::polish(std::vector<int>& best, int& cost, Deadline* deadline) {
+    Deadline grace(FINAL_GRACE);
+    candidate = best;
+    int candidateCost = cost;
+    if (!improve(candidate, candidateCost, deadline != nullptr ? deadline : &grace)) {
+        return false;
+    }
+    best.swap(candidate);
+    cost = candidateCost;
+    return true;
+}
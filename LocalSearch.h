@@ -0,0 +1,41 @@
+#ifndef PEA2_LOCAL_SEARCH_H
+#define PEA2_LOCAL_SEARCH_H
+
+#include <memory>
+#include <vector>
+#include "Deadline.h"
+#include "Neighborhood.h"
+
+// Deterministyczne doszlifowanie trasy: spadek po ruchach Or-opt i or-3opt (bez odwracania
+// segmentów, więc poprawny dla ATSP) z bitami don't-look. Przeglądane są tylko wierzchołki
+// aktywne - na starcie wszystkie, potem jedynie końce krawędzi zmienionych ostatnim ruchem.
+class LocalSearch {
+public:
+    LocalSearch(const MatrixView& matrix, std::shared_ptr<const CandidateLists> lists);
+
+    // Poprawia path w miejscu, aż do minimum lokalnego albo upływu czasu (deadline może być null).
+    // Zwraca true, jeśli koszt (aktualizowany w cost) spadł.
+    bool improve(std::vector<int>& path, int& cost, Deadline* deadline = nullptr);
+
+    // Szlifuje kopię best; best i cost zmieniane są tylko przy poprawie. Bez deadline (trasa
+    // końcowa, gdy limit przebiegu już minął) spadek trwa najwyżej FINAL_GRACE sekund.
+    bool polish(std::vector<int>& best, int& cost, Deadline* deadline = nullptr);
+
+    static constexpr double FINAL_GRACE = 0.5;
+
+private:
+    Neighborhood orOpt;
+    Neighborhood or3Opt;
+    std::vector<int> position;
+    std::vector<char> queued; // Odwrotność bitu don't-look: wierzchołek czeka w kolejce.
+    // Kolejka cykliczna aktywnych wierzchołków. Każdy jest w niej co najwyżej raz (queued),
+    // więc wystarcza n miejsc przydzielonych przy pierwszym wywołaniu.
+    std::vector<int> active;
+    int head = 0;
+    int count = 0;
+    std::vector<int> candidate; // Kopia robocza w polish(), używana ponownie bez alokacji.
+
+    void activate(int vertex);
+};
+
+#endif // PEA2_LOCAL_SEARCH_H
@@ -0,0 +1,69 @@
+#include "MappedFile.h"
+
+#include <cstdio>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+#ifndef _WIN32
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* address = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address != MAP_FAILED) {
+            madvise(address, (size_t)info.st_size, MADV_SEQUENTIAL); // Czytamy plik od początku do końca.
+            ::close(fd);
+            begin = static_cast<const char*>(address);
+            length = (size_t)info.st_size;
+            mapped = true;
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+    // Odczyt awaryjny: cały plik blokami po 1 MB.
+    FILE* file = std::fopen(filename.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    const size_t blockSize = 1 << 20;
+    size_t used = 0;
+    while (true) {
+        buffer.resize(used + blockSize);
+        size_t read = std::fread(buffer.data() + used, 1, blockSize, file);
+        used += read;
+        if (read < blockSize) {
+            break;
+        }
+    }
+    std::fclose(file);
+    buffer.resize(used);
+    begin = buffer.data();
+    length = used;
+    return true;
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char*>(begin), length);
+    }
+#endif
+    mapped = false;
+    begin = nullptr;
+    length = 0;
+    buffer.clear();
+}
@@ -0,0 +1,28 @@
+#ifndef PEA2_MAPPED_FILE_H
+#define PEA2_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Plik tylko do odczytu widoczny jako ciągły blok pamięci. Na systemach POSIX plik
+// jest mapowany przez mmap, w pozostałych przypadkach wczytywany dużymi blokami.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+    const char* data() const { return begin; }
+    size_t size() const { return length; }
+private:
+    const char* begin = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    std::vector<char> buffer; // Używany, gdy mmap jest niedostępny.
+};
+
+#endif // PEA2_MAPPED_FILE_H
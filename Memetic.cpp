@@ -0,0 +1,513 @@
+#include "Memetic.h"
+#include "AllocationCounter.h"
+#include "AnnealingSchedule.h"
+#include "Greedy.h"
+#include "Moves.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+namespace {
+
+// AB-cykle próbowane dla jednej pary rodziców; potomkiem zostaje najkrótsza z tras.
+const int EAX_TRIES = 5;
+
+// Pokolenia bez poprawy najlepszego wyniku, po których populacja jest odnawiana
+// z zaburzonych kopii najlepszej trasy.
+const int STAGNATION_GENERATIONS = 50;
+
+}
+
+MemeticAlgorithm::MemeticAlgorithm(const Adjacency_Matrix& graph, double time, uint64_t seed) : rng(seed) {
+    matrix = graph.getView(); // Widok na macierz sąsiedztwa grafu (bez kopiowania).
+    size = matrix.size();
+    timeBound = time;
+}
+
+MemeticAlgorithm::~MemeticAlgorithm() {
+}
+
+// Uruchamia algorytm i wypisuje wynik.
+void MemeticAlgorithm::apply() {
+    Tour result = solve();
+    std::ofstream file("wynikiMA.txt");
+    std::cout << "Droga: ";
+    for (int d = 0; d < size; d++) {
+        std::cout << result.path[d] << " ";
+        file << result.path[d] << " "; // Zapis do pliku.
+    }
+    std::cout << "\nKoszt: " << result.cost << std::endl;
+    std::cout << "Znaleziono po: " << result.foundTime << " s " << std::endl;
+}
+
+void MemeticAlgorithm::setOptions(const MemeticOptions& memetic) {
+    options = memetic;
+}
+
+void MemeticAlgorithm::setThreads(int threads) {
+    pool.reset(threads > 1 ? new WorkerPool(threads) : nullptr);
+}
+
+// Z sąsiedztwa brane są tylko listy kandydatów (bez list - 10 najbliższych).
+void MemeticAlgorithm::setNeighborhood(const Neighborhood& moves) {
+    lists = moves.candidateLists();
+}
+
+// Główna pętla: pokolenie potomków tworzonych równolegle, potem selekcja przeżywających.
+// Czas liczony jest zegarem ściennym sprawdzanym między pokoleniami i przed każdym potomkiem.
+Tour MemeticAlgorithm::solve(const SearchContext& context) {
+    Deadline deadline(timeBound, context.stop);
+    const int count = options.population > 0 ? options.population : std::min(100, std::max(20, 20000 / std::max(1, size)));
+    const int children = options.offspring > 0 ? options.offspring : count;
+    if (lists == nullptr) {
+        lists = std::make_shared<const CandidateLists>(matrix, 10);
+    }
+    // Dwa razy więcej zadań niż wątków wyrównuje nierówny czas przeszukiwania lokalnego.
+    const int tasks = pool != nullptr ? 2 * pool->size() : 1;
+    workspaces.resize(tasks);
+    for (Workspace& work : workspaces) {
+        for (std::vector<int>* buffer : {&work.tour, &work.parent, &work.successor, &work.predecessor, &work.other,
+                                         &work.otherPredecessor, &work.best, &work.label, &work.cycleStart, &work.cycleSize}) {
+            buffer->resize(size);
+        }
+        work.abCycles.reserve(size);
+        if (work.search == nullptr) {
+            work.search.reset(new LocalSearch(matrix, lists));
+        }
+    }
+    population.resize((size_t)count * size);
+    survivors.resize((size_t)count * size);
+    offspring.resize((size_t)children * size);
+    populationCost.resize(count);
+    survivorCost.resize(count);
+    offspringCost.resize(children);
+    roulette.resize(count);
+    order.resize(count + children);
+    chosen.resize(count);
+    stats = SolverStats();
+
+    // Populacja początkowa: trasy najbliższego sąsiada z równomiernie rozłożonych startów
+    // (powyżej n osobników dodatkowo zaburzone), poprawione przeszukiwaniem lokalnym.
+    // Po stagnacji ta sama funkcja odnawia osobniki 1.. z kopii najlepszego.
+    bool renewing = false;
+    uint64_t seed = rng();
+    const std::function<void(int)> rebuild = [&](int task) {
+        Workspace& work = workspaces[task];
+        for (int i = renewing ? task + 1 : task; i < count; i += tasks) {
+            Random random(seed + i);
+            if (renewing) {
+                std::copy(member(0), member(0) + size, work.tour.begin());
+                doubleBridgeKick(work.tour, 1 + size / 50, random);
+            } else {
+                std::vector<int> tour = greedyTour(matrix, (int)((long long)i * size / count % std::max(1, size)));
+                std::copy(tour.begin(), tour.end(), work.tour.begin());
+                if (i >= size) {
+                    doubleBridgeKick(work.tour, 1 + size / 100, random);
+                }
+            }
+            int cost = tourCost(matrix, work.tour);
+            improve(work, cost);
+            std::copy(work.tour.begin(), work.tour.end(), population.begin() + (size_t)i * size);
+            populationCost[i] = cost;
+        }
+    };
+    if (pool != nullptr) {
+        pool->run(tasks, rebuild);
+    } else {
+        rebuild(0);
+    }
+    survive(0);
+
+    Tour result;
+    result.path.assign(member(0), member(0) + size);
+    result.cost = populationCost[0];
+    result.foundTime = deadline.elapsed();
+    result.evaluations = count;
+    stats.improved(result.foundTime, result.cost);
+    if (context.globalBest != nullptr) {
+        context.globalBest->offer(result.path, result.cost, result.foundTime);
+    }
+
+    StagnationDetector stagnation(STAGNATION_GENERATIONS);
+    PeriodicTimer snapshotTimer(context.telemetry != nullptr ? context.telemetry->interval() : 0); // Migawki.
+    const std::function<void(int)> generation = [&](int task) {
+        for (int child = task; child < children; child += tasks) {
+            breed(child, seed + child, deadline, workspaces[task]);
+        }
+    };
+    const long long allocationBase = allocationCount(); // Alokacje sprzed pętli głównej nie są liczone.
+
+    while (!deadline.reached() && !context.budgetSpent(result.evaluations)) {
+        prepareSelection();
+        seed = rng();
+        if (pool != nullptr) {
+            pool->run(tasks, generation);
+        } else {
+            generation(0);
+        }
+        result.evaluations += children;
+        const int accepted = survive(children);
+        if (TELEMETRY_ENABLED) {
+            stats.iterations++;
+            stats.accepted += accepted;
+            stats.rejected += children - accepted;
+        }
+
+        const bool improved = populationCost[0] < result.cost;
+        if (improved) {
+            std::copy(member(0), member(0) + size, result.path.begin());
+            result.cost = populationCost[0];
+            result.foundTime = deadline.elapsed();
+            stats.improved(result.foundTime, result.cost);
+            if (context.globalBest != nullptr) {
+                context.globalBest->offer(result.path, result.cost, result.foundTime);
+            }
+        }
+
+        // Populacja zbiegła się do jednego minimum: odnowienie z zaburzonych kopii najlepszego.
+        if (stagnation.update(improved) && !deadline.reached()) {
+            stagnation.reset();
+            renewing = true;
+            seed = rng();
+            if (pool != nullptr) {
+                pool->run(tasks, rebuild);
+            } else {
+                rebuild(0);
+            }
+            survive(0);
+            result.evaluations += count - 1;
+            if (TELEMETRY_ENABLED) stats.restarts++;
+        }
+
+        // Okresowa migawka statystyk przebiegu (bieżący koszt - mediana populacji).
+        if (TELEMETRY_ENABLED && context.telemetry != nullptr && snapshotTimer.due(deadline.elapsed())) {
+            stats.evaluations = result.evaluations;
+            stats.allocations = allocationCount() - allocationBase;
+            context.telemetry->snapshot("ma", context.island, deadline.elapsed(), stats, populationCost[count / 2],
+                                        result.cost);
+        }
+    }
+
+    if (TELEMETRY_ENABLED && context.telemetry != nullptr) {
+        stats.evaluations = result.evaluations;
+        stats.allocations = allocationCount() - allocationBase;
+        context.telemetry->finish("ma", context.island, deadline.elapsed(), stats, result.cost);
+    }
+    return result;
+}
+
+// Jeden potomek: wybór rodziców, krzyżowanie, ewentualna mutacja, przeszukiwanie lokalne
+// i ocena. Zapisuje tylko własne miejsce w arenie potomków.
+void MemeticAlgorithm::breed(int child, uint64_t seed, const Deadline& deadline, Workspace& work) {
+    if (deadline.reached()) {
+        offspringCost[child] = INT_MAX; // Pominięty - selekcja go odrzuci.
+        return;
+    }
+    Random random(seed);
+    const int first = selectParent(random);
+    int second = selectParent(random);
+    for (int retry = 0; second == first && retry < 4; retry++) {
+        second = selectParent(random);
+    }
+    if (options.crossover == CrossoverKind::Order) {
+        orderCrossover(member(first), member(second), random, work);
+    } else if (!edgeAssembly(member(first), member(second), random, work)) {
+        std::copy(member(first), member(first) + size, work.tour.begin()); // Rodzice o tych samych krawędziach.
+    }
+    if (random.uniform() < options.mutation) {
+        doubleBridgeKick(work.tour, 1, random);
+    }
+    int cost = tourCost(matrix, work.tour);
+    improve(work, cost);
+    std::copy(work.tour.begin(), work.tour.end(), offspring.begin() + (size_t)child * size);
+    offspringCost[child] = cost;
+}
+
+void MemeticAlgorithm::improve(Workspace& work, int& cost) const {
+    if (options.localSearch) {
+        work.search->improve(work.tour, cost);
+    }
+}
+
+// Populacja jest posortowana rosnąco kosztem, więc mniejszy indeks to lepszy osobnik.
+int MemeticAlgorithm::selectParent(Random& random) const {
+    const int count = (int)populationCost.size();
+    switch (options.selection) {
+        case SelectionKind::Tournament: {
+            int winner = (int)random.below(count);
+            for (int round = 1; round < options.tournament; round++) {
+                winner = std::min(winner, (int)random.below(count));
+            }
+            return winner;
+        }
+        case SelectionKind::Rank: {
+            // Wagi count - i: odwrócona dystrybuanta rozkładu trójkątnego.
+            const int index = (int)(count * (1.0 - std::sqrt(1.0 - random.uniform())));
+            return std::min(index, count - 1);
+        }
+        case SelectionKind::Roulette: {
+            const double target = random.uniform() * roulette.back();
+            return std::min((int)(std::upper_bound(roulette.begin(), roulette.end(), target) - roulette.begin()),
+                            count - 1);
+        }
+    }
+    return 0;
+}
+
+void MemeticAlgorithm::prepareSelection() {
+    if (options.selection != SelectionKind::Roulette) {
+        return;
+    }
+    const double worst = populationCost.back();
+    double total = 0;
+    for (size_t i = 0; i < populationCost.size(); i++) {
+        total += worst - populationCost[i] + 1;
+        roulette[i] = total;
+    }
+}
+
+// Krzyżowanie porządkowe (OX): odcinek [i, j] z pierwszego rodzica zostaje na swoich
+// pozycjach, a pozostałe wierzchołki wpisywane są za nim w kolejności z drugiego rodzica.
+void MemeticAlgorithm::orderCrossover(const int* first, const int* second, Random& random, Workspace& work) const {
+    const int n = size;
+    std::vector<int>& tour = work.tour;
+    if (n < 3) {
+        std::copy(first, first + n, tour.begin());
+        return;
+    }
+    int i = (int)random.below(n);
+    int j = (int)random.below(n);
+    if (i > j) {
+        std::swap(i, j);
+    }
+    std::vector<int>& used = work.label;
+    std::fill(used.begin(), used.end(), 0);
+    for (int p = i; p <= j; p++) {
+        tour[p] = first[p];
+        used[first[p]] = 1;
+    }
+    int p = j + 1 == n ? 0 : j + 1;
+    for (int q = 0; q < n; q++) {
+        const int v = second[(j + 1 + q) % n];
+        if (!used[v]) {
+            tour[p] = v;
+            p = p + 1 == n ? 0 : p + 1;
+        }
+    }
+}
+
+// EAX dla grafu skierowanego. AB-cykl na przemian idzie krawędzią pierwszego rodzica A
+// (v -> succA(v)) i wstecz krawędzią drugiego B (do predB(succA(v))), więc AB-cykle to
+// cykle permutacji sigma(v) = predB(succA(v)); punkty stałe to krawędzie wspólne. Zamiana
+// krawędzi A z AB-cyklu na krawędzie B zachowuje stopnie wierzchołków, ale może rozbić
+// trasę na podcykle, które mergeSubtours łączy z powrotem. Próbowanych jest do EAX_TRIES
+// losowych AB-cykli, a potomkiem zostaje najkrótsza trasa. Zwraca false, gdy rodzice
+// mają te same krawędzie.
+bool MemeticAlgorithm::edgeAssembly(const int* first, const int* second, Random& random, Workspace& work) const {
+    const int n = size;
+    std::vector<int>& parent = work.parent;
+    std::vector<int>& other = work.other;
+    std::vector<int>& otherPredecessor = work.otherPredecessor;
+    int parentCost = 0;
+    for (int i = 0; i < n; i++) {
+        const int next = i + 1 == n ? 0 : i + 1;
+        parent[first[i]] = first[next];
+        parentCost += matrix(first[i], first[next]);
+        other[second[i]] = second[next];
+        otherPredecessor[second[next]] = second[i];
+    }
+
+    std::vector<int>& visited = work.label;
+    std::fill(visited.begin(), visited.end(), 0);
+    work.abCycles.clear();
+    for (int v = 0; v < n; v++) {
+        if (visited[v]) {
+            continue;
+        }
+        int length = 0;
+        int u = v;
+        do {
+            visited[u] = 1;
+            u = otherPredecessor[parent[u]];
+            length++;
+        } while (u != v);
+        if (length > 1) {
+            work.abCycles.push_back(v); // Pojemność n zarezerwowana - bez alokacji.
+        }
+    }
+    if (work.abCycles.empty()) {
+        return false;
+    }
+
+    int bestCost = INT_MAX;
+    const int tries = std::min(EAX_TRIES, (int)work.abCycles.size());
+    for (int t = 0; t < tries; t++) {
+        // Częściowe tasowanie: kolejne próby dostają różne AB-cykle.
+        std::swap(work.abCycles[t], work.abCycles[t + random.below((uint32_t)work.abCycles.size() - t)]);
+        const int start = work.abCycles[t];
+        std::copy(parent.begin(), parent.end(), work.successor.begin());
+        int cost = parentCost;
+        int v = start;
+        do {
+            const int target = parent[v];
+            const int from = otherPredecessor[target]; // Krawędź B from -> target zastępuje v -> target.
+            work.successor[from] = target;
+            cost += matrix(from, target) - matrix(v, target);
+            v = from;
+        } while (v != start);
+        cost += mergeSubtours(work);
+        if (cost < bestCost) {
+            bestCost = cost;
+            work.best.swap(work.successor);
+        }
+    }
+
+    int v = first[0];
+    for (int i = 0; i < n; i++) {
+        work.tour[i] = v;
+        v = work.best[v];
+    }
+    return true;
+}
+
+// Łączy podcykle listy następników w jedną trasę. Najmniejszy podcykl S jest dołączany
+// do innego przez wymianę dwóch krawędzi: a -> a' z S i b -> b' spoza S zastępowane są
+// przez a -> b' i b -> a'. Kandydatami na b' są najbliżsi następnicy a (listy kandydatów);
+// gdy wszyscy leżą w S, przeglądane są wszystkie wierzchołki. Zwraca zmianę kosztu.
+int MemeticAlgorithm::mergeSubtours(Workspace& work) const {
+    const int n = size;
+    std::vector<int>& successor = work.successor;
+    std::vector<int>& predecessor = work.predecessor;
+    std::vector<int>& label = work.label;
+    std::fill(label.begin(), label.end(), -1);
+    int cycles = 0;
+    for (int v = 0; v < n; v++) {
+        if (label[v] >= 0) {
+            continue;
+        }
+        int length = 0;
+        int u = v;
+        do {
+            label[u] = cycles;
+            predecessor[successor[u]] = u;
+            u = successor[u];
+            length++;
+        } while (u != v);
+        work.cycleStart[cycles] = v;
+        work.cycleSize[cycles] = length;
+        cycles++;
+    }
+
+    int delta = 0;
+    for (int alive = cycles; alive > 1; alive--) {
+        int smallest = -1;
+        for (int c = 0; c < cycles; c++) {
+            if (work.cycleSize[c] > 0 && (smallest < 0 || work.cycleSize[c] < work.cycleSize[smallest])) {
+                smallest = c;
+            }
+        }
+        int bestDelta = INT_MAX, bestFrom = -1, bestTo = -1;
+        auto consider = [&](int a, int target) {
+            const int a2 = successor[a];
+            const int b = predecessor[target];
+            const int change = matrix(a, target) + matrix(b, a2) - matrix(a, a2) - matrix(b, target);
+            if (change < bestDelta) {
+                bestDelta = change;
+                bestFrom = a;
+                bestTo = target;
+            }
+        };
+        const int start = work.cycleStart[smallest];
+        int a = start;
+        do {
+            const int* near = lists->of(a);
+            for (int j = 0; j < lists->size(); j++) {
+                if (label[near[j]] != smallest) {
+                    consider(a, near[j]);
+                }
+            }
+            a = successor[a];
+        } while (a != start);
+        if (bestFrom < 0) {
+            do {
+                for (int target = 0; target < n; target++) {
+                    if (label[target] != smallest) {
+                        consider(a, target);
+                    }
+                }
+                a = successor[a];
+            } while (a != start);
+        }
+
+        const int a2 = successor[bestFrom];
+        const int b = predecessor[bestTo];
+        const int merged = label[bestTo];
+        successor[bestFrom] = bestTo;
+        predecessor[bestTo] = bestFrom;
+        successor[b] = a2;
+        predecessor[a2] = b;
+        for (int u = a2; label[u] == smallest; u = successor[u]) {
+            label[u] = merged;
+        }
+        work.cycleStart[merged] = bestTo;
+        work.cycleSize[merged] += work.cycleSize[smallest];
+        work.cycleSize[smallest] = 0;
+        delta += bestDelta;
+    }
+    return delta;
+}
+
+// Selekcja elitarna z populacji i children pierwszych potomków: najpierw najlepsze trasy
+// o różnych kosztach (duplikaty kosztu to zwykle te same trasy), a brakujące miejsca
+// zajmują najlepsze z pozostałych. Nowe pokolenie trafia posortowane do areny survivors,
+// która zamienia się z populacją. Zwraca liczbę potomków, którzy przeżyli.
+int MemeticAlgorithm::survive(int children) {
+    const int count = (int)populationCost.size();
+    const int total = count + children;
+    auto costOf = [&](int index) { return index < count ? populationCost[index] : offspringCost[index - count]; };
+    for (int i = 0; i < total; i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.begin() + total, [&](int x, int y) {
+        const int cx = costOf(x), cy = costOf(y);
+        return cx != cy ? cx < cy : x < y;
+    });
+
+    int filled = 0;
+    int rest = 0; // Pominięte duplikaty przesuwane na początek order (zachowują kolejność).
+    for (int r = 0; r < total; r++) {
+        const int index = order[r];
+        const int cost = costOf(index);
+        if (cost == INT_MAX) {
+            continue;
+        }
+        if (filled < count && (filled == 0 || cost != costOf(chosen[filled - 1]))) {
+            chosen[filled++] = index;
+        } else {
+            order[rest++] = index;
+        }
+    }
+    for (int r = 0; filled < count && r < rest; r++) {
+        chosen[filled++] = order[r];
+    }
+    std::sort(chosen.begin(), chosen.begin() + filled, [&](int x, int y) {
+        const int cx = costOf(x), cy = costOf(y);
+        return cx != cy ? cx < cy : x < y;
+    });
+
+    int accepted = 0;
+    for (int slot = 0; slot < filled; slot++) {
+        const int index = chosen[slot];
+        const int* source = index < count ? member(index) : offspring.data() + (size_t)(index - count) * size;
+        std::copy(source, source + size, survivors.begin() + (size_t)slot * size);
+        survivorCost[slot] = costOf(index);
+        accepted += index >= count;
+    }
+    population.swap(survivors);
+    populationCost.swap(survivorCost);
+    return accepted;
+}
@@ -0,0 +1,91 @@
+#ifndef PEA2_MEMETIC_H
+#define PEA2_MEMETIC_H
+
+#include "adjacency_matrix.h"
+#include "LocalSearch.h"
+#include "Neighborhood.h"
+#include "SearchContext.h"
+#include "WorkerPool.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+// Krzyżowanie: OX zachowuje kolejność wierzchołków obu rodziców, EAX - krawędzie (skierowane).
+enum class CrossoverKind { Order, EdgeAssembly };
+
+// Wybór rodziców z populacji posortowanej rosnąco kosztem.
+enum class SelectionKind {
+    Tournament, // Najlepszy z tournament losowych osobników.
+    Rank,       // Prawdopodobieństwo malejące liniowo z pozycją w rankingu.
+    Roulette,   // Prawdopodobieństwo proporcjonalne do (najgorszy koszt - koszt + 1).
+};
+
+struct MemeticOptions {
+    int population = 0;   // Liczba osobników (0 - od 20 do 100 zależnie od n).
+    int offspring = 0;    // Potomków na pokolenie (0 - tyle, ile osobników).
+    CrossoverKind crossover = CrossoverKind::EdgeAssembly;
+    SelectionKind selection = SelectionKind::Tournament;
+    int tournament = 3;
+    double mutation = 0.1; // Prawdopodobieństwo zaburzenia potomka przestawieniem double bridge.
+    bool localSearch = true; // Or-opt/or-3opt na każdym potomku.
+};
+
+// Algorytm memetyczny: populacja tras poprawianych przeszukiwaniem lokalnym, krzyżowanie
+// OX albo EAX i selekcja elitarna z odrzucaniem duplikatów kosztu. Trasy populacji leżą
+// w jednym ciągłym buforze (osobnik i zajmuje size kolejnych liczb), bez osobnych wektorów.
+// Potomkowie są tworzeni, poprawiani i oceniani równolegle na puli wątków; każdy ma własny
+// strumień liczb losowych zależny tylko od ziarna i numeru, więc wynik pokolenia nie zależy
+// od liczby wątków.
+class MemeticAlgorithm {
+public:
+    MemeticAlgorithm(const Adjacency_Matrix& graph, double time, uint64_t seed = std::random_device()());
+    ~MemeticAlgorithm();
+    void apply();
+    Tour solve(const SearchContext& context = SearchContext()); // Przebieg bez wypisywania wyników.
+    void setOptions(const MemeticOptions& options);
+    void setThreads(int threads); // Wątki tworzące potomków (domyślnie 1).
+    void setNeighborhood(const Neighborhood& moves); // Listy kandydatów dla przeszukiwania lokalnego i EAX.
+    const SolverStats& statistics() const { return stats; }
+private:
+    // Bufory robocze jednego zadania puli (wielkości n, przydzielane raz na przebieg).
+    struct Workspace {
+        std::vector<int> tour;
+        std::vector<int> parent;     // Następniki pierwszego rodzica.
+        std::vector<int> successor, predecessor; // Budowany potomek jako lista następników.
+        std::vector<int> other, otherPredecessor; // Następniki i poprzedniki drugiego rodzica.
+        std::vector<int> best;       // Następniki najlepszego potomka EAX danej pary.
+        std::vector<int> label;      // Podcykl wierzchołka (EAX) albo znacznik użycia (OX).
+        std::vector<int> cycleStart, cycleSize;
+        std::vector<int> abCycles;   // Wierzchołek startowy każdego AB-cyklu.
+        std::unique_ptr<LocalSearch> search;
+    };
+
+    MatrixView matrix; // Widok na macierz grafu; graf musi żyć dłużej niż solver.
+    int size;
+    double timeBound;
+    MemeticOptions options;
+    std::shared_ptr<const CandidateLists> lists;
+    std::unique_ptr<WorkerPool> pool;
+    std::vector<Workspace> workspaces;
+    // Areny tras: osobnik i zajmuje [i * size, (i + 1) * size). Populacja jest posortowana
+    // rosnąco kosztem; survivors to bufor, do którego selekcja przepisuje nowe pokolenie.
+    std::vector<int> population, offspring, survivors;
+    std::vector<int> populationCost, offspringCost, survivorCost;
+    std::vector<double> roulette; // Skumulowane wagi ruletki.
+    std::vector<int> order;       // Kolejność kandydatów przy selekcji przeżywających.
+    std::vector<int> chosen;      // Indeksy kandydatów wybranych do nowego pokolenia.
+    SolverStats stats;
+    Random rng;
+
+    const int* member(int index) const { return population.data() + (size_t)index * size; }
+    int selectParent(Random& random) const;
+    void breed(int child, uint64_t seed, const Deadline& deadline, Workspace& work);
+    void orderCrossover(const int* first, const int* second, Random& random, Workspace& work) const;
+    bool edgeAssembly(const int* first, const int* second, Random& random, Workspace& work) const;
+    int mergeSubtours(Workspace& work) const;
+    void improve(Workspace& work, int& cost) const;
+    int survive(int children);
+    void prepareSelection();
+};
+
+#endif // PEA2_MEMETIC_H
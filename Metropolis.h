@@ -0,0 +1,42 @@
+#ifndef PEA2_METROPOLIS_H
+#define PEA2_METROPOLIS_H
+
+#include <cmath>
+#include "Random.h"
+
+// Progi akceptacji: NEGATIVE_LOG[i] = -ln(i / ACCEPT_BUCKETS). Dla u z przedziału
+// [i, i+1) / ACCEPT_BUCKETS wartość -ln(u) leży między NEGATIVE_LOG[i+1] a NEGATIVE_LOG[i].
+const int ACCEPT_BUCKETS = 4096;
+
+struct NegativeLogTable {
+    double value[ACCEPT_BUCKETS + 1];
+    NegativeLogTable() {
+        value[0] = HUGE_VAL;
+        for (int i = 1; i <= ACCEPT_BUCKETS; i++) {
+            value[i] = -std::log((double)i / ACCEPT_BUCKETS);
+        }
+    }
+};
+
+inline const NegativeLogTable NEGATIVE_LOG; // Jedna tablica w całym programie (zmienna inline).
+
+// Kryterium Metropolisa bez exp(): przejście o koszcie delta przyjmowane jest, gdy
+// delta / T < -ln(u). Przedział tablicy, do którego trafia u, zwykle rozstrzyga porównanie;
+// logarytm liczony jest tylko wtedy, gdy delta / T wypada wewnątrz tego przedziału progów.
+inline bool metropolisAccept(double delta, double inverseTemperature, Random& rng) {
+    if (delta <= 0) {
+        return true;
+    }
+    const double scaled = delta * inverseTemperature;
+    const double u = rng.uniform();
+    const int bucket = (int)(u * ACCEPT_BUCKETS);
+    if (scaled < NEGATIVE_LOG.value[bucket + 1]) {
+        return true;
+    }
+    if (scaled >= NEGATIVE_LOG.value[bucket]) {
+        return false;
+    }
+    return scaled < -std::log(u);
+}
+
+#endif // PEA2_METROPOLIS_H
@@ -0,0 +1,78 @@
+#ifndef PEA2_MOVES_H
+#define PEA2_MOVES_H
+
+#include <vector>
+#include "DistanceMatrix.h"
+
+// Koszt cyklu path[0] -> ... -> path[n-1] -> path[0]. Wersja ze wskaźnikiem i długością
+// działa na dowolnym buforze trasy (np. fragmencie większej tablicy) bez kopiowania.
+inline int tourCost(const MatrixView& matrix, const int* path, int n) {
+    if (n == 0) {
+        return 0;
+    }
+    int cost = matrix(path[n - 1], path[0]);
+    for (int i = 0; i + 1 < n; i++) {
+        cost += matrix(path[i], path[i + 1]);
+    }
+    return cost;
+}
+
+inline int tourCost(const MatrixView& matrix, const std::vector<int>& path) {
+    return tourCost(matrix, path.data(), (int)path.size());
+}
+
+// Zmiana kosztu cyklu, gdy wierzchołek a (poprzedzany przez p) i wierzchołek b
+// (po którym następuje q) sąsiadują w cyklu w kolejności p -> a -> b -> q.
+inline int adjacentSwapDelta(const MatrixView& matrix, int p, int a, int b, int q) {
+    int oldCost = matrix(p, a) + matrix(a, b) + matrix(b, q);
+    int newCost = matrix(p, b) + matrix(b, a) + matrix(a, q);
+    return newCost - oldCost;
+}
+
+// Zmiana kosztu cyklu po zamianie wierzchołków na pozycjach i oraz j.
+// Zamiast liczyć koszt całej ścieżki od nowa, brane są pod uwagę tylko krawędzie
+// wchodzące do i wychodzące z obu pozycji. Macierz może być asymetryczna, dlatego
+// pozycje sąsiednie oraz para (0, n-1) sąsiadująca przez zawinięcie cyklu są
+// obsługiwane osobno.
+inline int swapDelta(const MatrixView& matrix, const std::vector<int>& path, int i, int j) {
+    int n = path.size();
+    if (i == j || n < 3) {
+        return 0; // Dla n < 3 każda zamiana daje cykl o tym samym koszcie.
+    }
+    if (i > j) {
+        int t = i; i = j; j = t;
+    }
+    int a = path[i];
+    int b = path[j];
+    if (j == i + 1) {
+        // Pozycje sąsiednie: p -> a -> b -> q.
+        return adjacentSwapDelta(matrix, path[(i + n - 1) % n], a, b, path[(j + 1) % n]);
+    }
+    if (i == 0 && j == n - 1) {
+        // Sąsiedztwo przez zawinięcie cyklu: path[n-2] -> b -> a -> path[1].
+        return adjacentSwapDelta(matrix, path[j - 1], b, a, path[i + 1]);
+    }
+    int prevA = path[(i + n - 1) % n];
+    int nextA = path[i + 1];
+    int prevB = path[j - 1];
+    int nextB = path[(j + 1) % n];
+    int oldCost = matrix(prevA, a) + matrix(a, nextA) + matrix(prevB, b) + matrix(b, nextB);
+    int newCost = matrix(prevA, b) + matrix(b, nextA) + matrix(prevB, a) + matrix(a, nextB);
+    return newCost - oldCost;
+}
+
+// Zmiana kosztu cyklu po wymianie segmentów bez odwracania (3-opt zachowujący kierunek,
+// "or-3opt"). Cięcia po pozycjach a < b < c dzielą cykl na A = ..a, B = a+1..b,
+// C = b+1..c, a cykl A B C zamieniany jest na A C B. Przeniesienie krótkiego segmentu
+// (Or-opt, wstawianie) to szczególny przypadek tej wymiany.
+inline int exchangeDelta(const MatrixView& matrix, const std::vector<int>& path, int a, int b, int c) {
+    int n = path.size();
+    int p = path[a], pNext = path[a + 1];
+    int q = path[b], qNext = path[b + 1];
+    int r = path[c], rNext = path[(c + 1) % n];
+    int oldCost = matrix(p, pNext) + matrix(q, qNext) + matrix(r, rNext);
+    int newCost = matrix(p, qNext) + matrix(r, pNext) + matrix(q, rNext);
+    return newCost - oldCost;
+}
+
+#endif // PEA2_MOVES_H
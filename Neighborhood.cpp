@@ -0,0 +1,64 @@
+#include "Neighborhood.h"
+
+#include <algorithm>
+
+CandidateLists::CandidateLists(const MatrixView& matrix, int k) {
+    const int n = matrix.size();
+    this->k = std::max(1, std::min(k, n - 1));
+    lists.resize((size_t)n * this->k);
+    std::vector<int> others;
+    others.reserve(n);
+    for (int v = 0; v < n; v++) {
+        others.clear();
+        for (int u = 0; u < n; u++) {
+            if (u != v) others.push_back(u);
+        }
+        if (others.empty()) {
+            others.push_back(v); // Instancja jednowierzchołkowa.
+        }
+        const Weight* row = matrix.row(v);
+        std::partial_sort(others.begin(), others.begin() + this->k, others.end(),
+                          [row](int x, int y) { return row[x] < row[y] || (row[x] == row[y] && x < y); });
+        std::copy(others.begin(), others.begin() + this->k, lists.begin() + (size_t)v * this->k);
+    }
+}
+
+Neighborhood::Neighborhood(const MatrixView& matrix, NeighborhoodKind kind, int candidateCount)
+    : matrix(matrix), type(kind) {
+    if (kind != NeighborhoodKind::FullSwap) {
+        candidates = std::make_shared<const CandidateLists>(matrix, candidateCount);
+    }
+}
+
+Neighborhood::Neighborhood(const MatrixView& matrix, NeighborhoodKind kind, std::shared_ptr<const CandidateLists> lists)
+    : matrix(matrix), type(kind), candidates(std::move(lists)) {
+}
+
+void Neighborhood::apply(const Move& move, std::vector<int>& path, std::vector<int>& position) {
+    if (move.c < 0) {
+        std::swap(path[move.a], path[move.b]);
+        position[path[move.a]] = move.a;
+        position[path[move.b]] = move.b;
+        return;
+    }
+    // A B C -> A C B: obrót fragmentu a+1..c i odświeżenie pozycji tylko w tym fragmencie.
+    std::rotate(path.begin() + move.a + 1, path.begin() + move.b + 1, path.begin() + move.c + 1);
+    for (int p = move.a + 1; p <= move.c; p++) {
+        position[path[p]] = p;
+    }
+}
+
+void Neighborhood::apply(const Move& move, std::vector<int>& path) {
+    if (move.c < 0) {
+        std::swap(path[move.a], path[move.b]);
+    } else {
+        std::rotate(path.begin() + move.a + 1, path.begin() + move.b + 1, path.begin() + move.c + 1);
+    }
+}
+
+void Neighborhood::indexPositions(const std::vector<int>& path, std::vector<int>& position) {
+    position.resize(path.size());
+    for (int p = 0; p < (int)path.size(); p++) {
+        position[path[p]] = p;
+    }
+}
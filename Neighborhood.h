@@ -0,0 +1,209 @@
+#ifndef PEA2_NEIGHBORHOOD_H
+#define PEA2_NEIGHBORHOOD_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "DistanceMatrix.h"
+#include "Moves.h"
+#include "Random.h"
+
+// Rodzaje sąsiedztwa wybierane w solverach. FullSwap to pierwotny pełny przegląd zamian
+// wszystkich par pozycji; pozostałe sąsiedztwa są ograniczone do list kandydatów.
+enum class NeighborhoodKind { FullSwap, Swap, OrOpt, Or3Opt };
+
+// Dla każdego wierzchołka k najbliższych następników (wg wag wychodzących), liczone raz
+// dla instancji i współdzielone przez wszystkie kopie Neighborhood.
+class CandidateLists {
+public:
+    CandidateLists(const MatrixView& matrix, int k);
+    const int* of(int vertex) const { return lists.data() + (size_t)vertex * k; }
+    int size() const { return k; }
+private:
+    int k = 0;
+    std::vector<int> lists;
+};
+
+// Ruch na cyklu: zamiana pozycji a i b (c < 0) albo wymiana segmentów a < b < c (exchangeDelta).
+struct Move {
+    int a = 0, b = 0, c = -1;
+    int delta = 0;
+};
+
+// Sąsiedztwo z ruchami ocenianymi w O(1) i kandydatami z list k najbliższych, dzięki czemu
+// przegląd kosztuje O(n*k) (Or3Opt: O(n*k^2)) zamiast O(n^2). Pozycje wierzchołków
+// w cyklu (position[v]) utrzymuje wywołujący, m.in. przez apply().
+class Neighborhood {
+public:
+    Neighborhood() = default; // FullSwap - solvery używają wtedy własnego przeglądu.
+    Neighborhood(const MatrixView& matrix, NeighborhoodKind kind, int candidates = 10);
+    Neighborhood(const MatrixView& matrix, NeighborhoodKind kind, std::shared_ptr<const CandidateLists> lists);
+
+    NeighborhoodKind kind() const { return type; }
+    std::shared_ptr<const CandidateLists> candidateLists() const { return candidates; } // null dla FullSwap
+
+    // To samo sąsiedztwo (rodzaj i współdzielone listy kandydatów) z ruchami ocenianymi na matrix.
+    // Solvery wiążą tak przekazane sąsiedztwo z własną macierzą.
+    Neighborhood rebind(const MatrixView& matrix) const { return Neighborhood(matrix, type, candidates); }
+
+    // Wywołuje visit(const Move&) dla każdego ruchu z list kandydatów.
+    template <typename Visitor>
+    void forEachMove(const std::vector<int>& path, const std::vector<int>& position, Visitor&& visit) const;
+    // To samo tylko dla ruchów zaczepionych na pozycji p (np. dla przeszukiwania z bitami don't-look).
+    template <typename Visitor>
+    void forEachMoveAt(int p, const std::vector<int>& path, const std::vector<int>& position, Visitor&& visit) const;
+
+    // Losowy ruch z list kandydatów; ruch pusty (delta 0), jeśli wylosowane cięcia się pokrywają.
+    Move randomMove(const std::vector<int>& path, const std::vector<int>& position, Random& rng) const;
+
+    static void apply(const Move& move, std::vector<int>& path, std::vector<int>& position);
+    static void apply(const Move& move, std::vector<int>& path); // Bez aktualizacji pozycji.
+    static void indexPositions(const std::vector<int>& path, std::vector<int>& position);
+
+private:
+    static const int MAX_SEGMENT = 3; // Najdłuższy segment przenoszony przez Or-opt.
+
+    MatrixView matrix;
+    NeighborhoodKind type = NeighborhoodKind::FullSwap;
+    std::shared_ptr<const CandidateLists> candidates;
+
+    bool swapMove(const std::vector<int>& path, int i, int j, Move& move) const;
+    bool exchangeMove(const std::vector<int>& path, int x, int y, int z, Move& move) const;
+    bool orOptMove(const std::vector<int>& path, const std::vector<int>& position, int s, int length, int target, Move& move) const;
+    bool or3OptMove(const std::vector<int>& path, const std::vector<int>& position, int a, int u, int w, Move& move) const;
+};
+
+inline bool Neighborhood::swapMove(const std::vector<int>& path, int i, int j, Move& move) const {
+    if (i == j) {
+        return false;
+    }
+    move.a = i < j ? i : j;
+    move.b = i < j ? j : i;
+    move.c = -1;
+    move.delta = swapDelta(matrix, path, move.a, move.b);
+    return true;
+}
+
+// Trzy różne cięcia (po pozycjach x, y, z) w dowolnej kolejności.
+inline bool Neighborhood::exchangeMove(const std::vector<int>& path, int x, int y, int z, Move& move) const {
+    if (x == y || y == z || x == z) {
+        return false;
+    }
+    if (x > y) std::swap(x, y);
+    if (y > z) std::swap(y, z);
+    if (x > y) std::swap(x, y);
+    move.a = x;
+    move.b = y;
+    move.c = z;
+    move.delta = exchangeDelta(matrix, path, x, y, z);
+    return true;
+}
+
+// Przeniesienie segmentu path[s..s+length-1] przed wierzchołek target (nowa krawędź koniec -> target).
+inline bool Neighborhood::orOptMove(const std::vector<int>& path, const std::vector<int>& position, int s, int length, int target, Move& move) const {
+    int n = path.size();
+    int q = position[target];
+    if (s + length > n || (q >= s && q <= s + length)) {
+        return false;
+    }
+    return exchangeMove(path, (s + n - 1) % n, s + length - 1, (q + n - 1) % n, move);
+}
+
+// Wymiana segmentów z nowymi krawędziami path[a] -> u oraz (poprzednik u) -> w.
+inline bool Neighborhood::or3OptMove(const std::vector<int>& path, const std::vector<int>& position, int a, int u, int w, Move& move) const {
+    int n = path.size();
+    int b = (position[u] + n - 1) % n;
+    int c = (position[w] + n - 1) % n;
+    // Cięcia muszą leżeć na cyklu w kolejności a -> b -> c, inaczej powstałyby inne krawędzie.
+    if ((b - a + n) % n >= (c - a + n) % n) {
+        return false;
+    }
+    return exchangeMove(path, a, b, c, move);
+}
+
+template <typename Visitor>
+void Neighborhood::forEachMove(const std::vector<int>& path, const std::vector<int>& position, Visitor&& visit) const {
+    for (int p = 0; p < (int)path.size(); p++) {
+        forEachMoveAt(p, path, position, visit);
+    }
+}
+
+template <typename Visitor>
+void Neighborhood::forEachMoveAt(int p, const std::vector<int>& path, const std::vector<int>& position, Visitor&& visit) const {
+    const int n = path.size();
+    Move move;
+    if (type == NeighborhoodKind::FullSwap) {
+        for (int j = p + 1; j < n; j++) {
+            if (swapMove(path, p, j, move)) visit(move);
+        }
+        return;
+    }
+    const int k = candidates->size();
+    switch (type) {
+        case NeighborhoodKind::Swap: {
+            // Zamiana, po której path[p-1] prowadzi do bliskiego kandydata.
+            const int* near = candidates->of(path[(p + n - 1) % n]);
+            for (int t = 0; t < k; t++) {
+                if (swapMove(path, p, position[near[t]], move)) visit(move);
+            }
+            break;
+        }
+        case NeighborhoodKind::OrOpt:
+            for (int length = 1; length <= MAX_SEGMENT && length < n - 2 && p + length <= n; length++) {
+                const int* near = candidates->of(path[p + length - 1]);
+                for (int t = 0; t < k; t++) {
+                    if (orOptMove(path, position, p, length, near[t], move)) visit(move);
+                }
+            }
+            break;
+        case NeighborhoodKind::Or3Opt: {
+            const int* nearA = candidates->of(path[p]);
+            for (int t = 0; t < k; t++) {
+                int u = nearA[t];
+                const int* nearB = candidates->of(path[(position[u] + n - 1) % n]);
+                for (int r = 0; r < k; r++) {
+                    if (or3OptMove(path, position, p, u, nearB[r], move)) visit(move);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+inline Move Neighborhood::randomMove(const std::vector<int>& path, const std::vector<int>& position, Random& rng) const {
+    const uint32_t n = path.size();
+    Move move;
+    if (type == NeighborhoodKind::FullSwap) {
+        int i = rng.below(n);
+        swapMove(path, i, rng.below(n), move);
+        return move;
+    }
+    const uint32_t k = candidates->size();
+    int i = rng.below(n);
+    bool valid = false;
+    switch (type) {
+        case NeighborhoodKind::Swap:
+            valid = swapMove(path, i, position[candidates->of(path[(i + n - 1) % n])[rng.below(k)]], move);
+            break;
+        case NeighborhoodKind::OrOpt: {
+            int length = 1 + rng.below(MAX_SEGMENT);
+            if (i + length <= (int)n && length < (int)n - 2) {
+                valid = orOptMove(path, position, i, length, candidates->of(path[i + length - 1])[rng.below(k)], move);
+            }
+            break;
+        }
+        case NeighborhoodKind::Or3Opt: {
+            int u = candidates->of(path[i])[rng.below(k)];
+            int w = candidates->of(path[(position[u] + n - 1) % n])[rng.below(k)];
+            valid = or3OptMove(path, position, i, u, w, move);
+            break;
+        }
+        default:
+            break;
+    }
+    return valid ? move : Move();
+}
+
+#endif // PEA2_NEIGHBORHOOD_H
@@ -0,0 +1,173 @@
+#include "ParallelSolver.h"
+#include "Checkpoint.h"
+#include "ExactSolver.h"
+#include "ParallelTempering.h"
+#include "SimulatedAnnealing.h"
+#include "TabuSearch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+
+Tour solveParallel(const Adjacency_Matrix& graph, const ParallelOptions& options) {
+    int threads = options.threads > 0 ? options.threads : (int)std::thread::hardware_concurrency();
+    if (threads < 1) {
+        threads = 1;
+    }
+    SharedBest globalBest;
+    globalBest.setAnytime(options.anytime);
+    std::unique_ptr<IslandRing> ring;
+    if (options.islands) {
+        ring.reset(new IslandRing(threads));
+    }
+
+    // Listy kandydatów dla przeszukiwania lokalnego liczone raz dla wszystkich wątków.
+    std::shared_ptr<const CandidateLists> lists;
+    if (options.polish) {
+        lists = options.neighborhood.candidateLists();
+        if (lists == nullptr) {
+            lists = std::make_shared<const CandidateLists>(graph.getView(), 10);
+        }
+    }
+    if (options.kind == SolverKind::ParallelTempering) {
+        ParallelTempering solver(graph, options.searchTime,
+                                 options.replicas > 0 ? options.replicas : std::max(8, threads), options.seed);
+        solver.setThreads(threads);
+        solver.setNeighborhood(options.neighborhood);
+        if (lists != nullptr) {
+            solver.setPolish(lists);
+        }
+        SearchContext context;
+        context.globalBest = &globalBest;
+        context.stop = options.interrupt;
+        context.telemetry = options.telemetry;
+        context.evaluationLimit = options.evaluationLimit;
+        return solver.solve(context);
+    }
+    if (options.kind == SolverKind::Memetic) {
+        MemeticAlgorithm solver(graph, options.searchTime, options.seed);
+        solver.setOptions(options.memetic);
+        solver.setThreads(threads);
+        solver.setNeighborhood(options.neighborhood);
+        SearchContext context;
+        context.globalBest = &globalBest;
+        context.stop = options.interrupt;
+        context.telemetry = options.telemetry;
+        context.evaluationLimit = options.evaluationLimit;
+        return solver.solve(context);
+    }
+
+    if (options.kind == SolverKind::Exact) {
+        ExactSolver solver(graph, options.searchTime);
+        solver.setThreads(threads);
+        SearchContext context;
+        context.globalBest = &globalBest;
+        context.stop = options.interrupt;
+        context.telemetry = options.telemetry;
+        context.evaluationLimit = options.evaluationLimit;
+        return solver.solve(context);
+    }
+
+    // Solvery TS i SA tworzone są przed startem wątków, żeby pliki stanu (resume) wszystkich
+    // wątków zostały wczytane i sprawdzone, zanim cokolwiek zostanie policzone.
+    std::vector<std::unique_ptr<TabuSearch>> tabuSolvers(threads);
+    std::vector<std::unique_ptr<SimulatedAnnealing>> annealingSolvers(threads);
+    bool resumed = true;
+    auto prepare = [&](auto& solver, int i) {
+        solver.setNeighborhood(options.neighborhood);
+        if (lists != nullptr) {
+            solver.setPolish(lists, options.polishInterval);
+        }
+        if (!options.initialTour.empty()) {
+            solver.setInitialTour(options.initialTour);
+        }
+        if (!options.resume.empty()) {
+            resumed = solver.resume(checkpointFile(options.resume, i, threads)) && resumed;
+        }
+        if (!options.checkpoint.empty()) {
+            solver.setCheckpoint(checkpointFile(options.checkpoint, i, threads), options.checkpointInterval);
+        }
+    };
+    for (int i = 0; i < threads; i++) {
+        // Osobne, nieskorelowane ziarno dla każdego wątku.
+        std::seed_seq sequence{(uint32_t)options.seed, (uint32_t)(options.seed >> 32), (uint32_t)i};
+        uint32_t words[2];
+        sequence.generate(words, words + 2);
+        uint64_t seed = (uint64_t)words[0] << 32 | words[1];
+        if (options.kind == SolverKind::TabuSearch) {
+            tabuSolvers[i].reset(new TabuSearch(graph, options.searchTime, seed));
+            tabuSolvers[i]->setTenure(options.tabuTenure);
+            prepare(*tabuSolvers[i], i);
+        } else {
+            annealingSolvers[i].reset(new SimulatedAnnealing(graph, options.searchTime, options.coolingRate, seed));
+            annealingSolvers[i]->setSchedule(options.schedule);
+            prepare(*annealingSolvers[i], i);
+        }
+    }
+    // Stan zapisany przez więcej wątków niż teraz - część przebiegu zostałaby po cichu pominięta.
+    const std::string surplus = checkpointFile(options.resume, threads, threads + 1);
+    if (!options.resume.empty() && threads > 1 && std::ifstream(surplus).good()) {
+        std::cerr << "Stan zapisano na wiecej watkach niz " << threads << " (istnieje " << surplus << ")" << std::endl;
+        resumed = false;
+    }
+    if (!resumed) {
+        return Tour();
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<long long> evaluations{0};
+    std::mutex finishedMutex;
+    std::condition_variable finished;
+    int running = threads; // Wątki, które jeszcze nie zakończyły przebiegu (chronione finishedMutex).
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back([&, i]() {
+            SearchContext context;
+            context.globalBest = &globalBest;
+            context.islands = ring.get();
+            context.island = i;
+            context.migrationInterval = options.migrationInterval;
+            context.stop = &stop;
+            context.telemetry = options.telemetry;
+            context.evaluationLimit = options.evaluationLimit;
+            if (options.kind == SolverKind::TabuSearch) {
+                evaluations += tabuSolvers[i]->solve(context).evaluations;
+            } else {
+                evaluations += annealingSolvers[i]->solve(context).evaluations;
+            }
+            std::lock_guard<std::mutex> lock(finishedMutex);
+            running--;
+            finished.notify_one();
+        });
+    }
+    // Wątek wywołujący pełni rolę watchdoga: po upływie czasu albo po przerwaniu z zewnątrz
+    // zatrzymuje wszystkie wątki naraz. Zakończenie wszystkich wątków przed czasem (limit
+    // ocenionych ruchów) budzi go od razu; flaga przerwania sprawdzana jest co WATCHDOG_STEP.
+    typedef std::chrono::steady_clock Clock;
+    const Clock::duration WATCHDOG_STEP = std::chrono::milliseconds(50);
+    const Clock::time_point end = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                                     std::chrono::duration<double>(options.searchTime));
+    {
+        std::unique_lock<std::mutex> lock(finishedMutex);
+        while (running > 0 && Clock::now() < end
+               && (options.interrupt == nullptr || !options.interrupt->load(std::memory_order_relaxed))) {
+            finished.wait_until(lock, std::min(end, Clock::now() + WATCHDOG_STEP));
+        }
+    }
+    stop.store(true, std::memory_order_relaxed);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::shared_ptr<const Tour> best = globalBest.snapshot();
+    Tour result = best != nullptr ? *best : Tour();
+    result.evaluations = evaluations.load();
+    return result;
+}
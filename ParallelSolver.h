@@ -0,0 +1,52 @@
+#ifndef PEA2_PARALLEL_SOLVER_H
+#define PEA2_PARALLEL_SOLVER_H
+
+#include "adjacency_matrix.h"
+#include "AnnealingSchedule.h"
+#include "Memetic.h"
+#include "Neighborhood.h"
+#include "SearchContext.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+enum class SolverKind { TabuSearch, SimulatedAnnealing, ParallelTempering, Memetic, Exact };
+
+struct ParallelOptions {
+    SolverKind kind = SolverKind::TabuSearch;
+    int threads = 0;              // 0 = liczba rdzeni sprzętowych.
+    double searchTime = 5;        // Sekundy czasu ściennego dla każdego wątku.
+    long long evaluationLimit = 0; // > 0 - także limit ocenionych ruchów (TS i SA - każdego wątku,
+                                   // Exact - węzłów podziału i ograniczeń).
+    double coolingRate = 0.99;    // Używane tylko przez SimulatedAnnealing.
+    ScheduleOptions schedule;     // Harmonogram temperatury SimulatedAnnealing.
+    int replicas = 0;             // ParallelTempering: liczba łańcuchów (0 - max(8, threads)).
+    MemeticOptions memetic;       // Populacja, krzyżowanie i selekcja algorytmu memetycznego.
+    int tabuTenure = 0;           // Używane tylko przez TabuSearch (0 - liczba wierzchołków).
+    bool islands = false;         // Wymiana elitarnych tras między wątkami w pierścieniu.
+    double migrationInterval = 1.0;
+    uint64_t seed = 0;            // Ziarno bazowe; wątek i dostaje własny strumień z (seed, i).
+    Neighborhood neighborhood;    // Wspólne (tylko do odczytu) listy kandydatów dla wszystkich wątków.
+    bool polish = false;          // Przeszukiwanie lokalne najlepszej trasy każdego wątku.
+    double polishInterval = 0;    // Sekundy między szlifowaniami (0 - tylko na końcu).
+    TelemetrySink* telemetry = nullptr; // Migawki postępu każdego wątku (null - wyłączone).
+    AnytimeWriter* anytime = nullptr;   // Zapis każdej poprawy globalnego wyniku (null - wyłączony).
+    const std::atomic<bool>* interrupt = nullptr; // Ustawiona z zewnątrz (np. SIGINT) kończy przebieg przed czasem.
+    std::string checkpoint;       // TS i SA: plik stanu każdego wątku (checkpointFile, pusty - bez zapisu).
+    double checkpointInterval = 0; // Sekundy między zapisami stanu (0 - tylko na końcu przebiegu).
+    std::string resume;           // TS i SA: kontynuacja z plików stanu o tej nazwie bazowej (przy tej samej
+                                  // liczbie wątków; brak lub błąd pliku - pusta trasa zamiast przebiegu).
+    std::vector<int> initialTour; // TS i SA: trasa startowa zamiast zachłannej (pusta - zachłanna).
+};
+
+// Uruchamia niezależne instancje solvera na wszystkich wątkach. Wątki współdzielą
+// macierz tylko do odczytu i publikują poprawy do wspólnego najlepszego wyniku.
+// ParallelTempering i Memetic to jeden przebieg, którego łańcuchy lub potomkowie
+// rozdzielani są między wątki (model wyspowy ich nie dotyczy); Exact dzieli między
+// wątki warstwy Held-Karpa. Przebieg kończy się po searchTime, po wyczerpaniu
+// evaluationLimit albo po ustawieniu flagi interrupt; stan wątków TS i SA zapisywany
+// jest wtedy normalnie, jak po upływie czasu. Jeśli pliku stanu któregoś wątku (resume)
+// nie da się wczytać, przebieg nie startuje, a wynikiem jest pusta trasa.
+Tour solveParallel(const Adjacency_Matrix& graph, const ParallelOptions& options);
+
+#endif // PEA2_PARALLEL_SOLVER_H
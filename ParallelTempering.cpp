@@ -0,0 +1,240 @@
+#include "ParallelTempering.h"
+#include "AllocationCounter.h"
+#include "AnnealingSchedule.h"
+#include "Greedy.h"
+#include "Metropolis.h"
+#include "Moves.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+
+// Początkowy stosunek najwyższej do najniższej temperatury drabiny.
+const double INITIAL_SPAN = 1e4;
+
+// Docelowy odsetek przyjętych ruchów pod górę w najzimniejszym łańcuchu i krok, o jaki
+// po każdej rundzie zmienia się jego temperatura. Ruchy o delcie <= 0 nie są liczone -
+// przy listach kandydatów jest ich tyle, że zwykła akceptacja nie spada poniżej kilku procent.
+const double COLD_ACCEPTANCE = 0.0003;
+const double COLD_STEP = 1.1;
+
+// Ruchy każdego łańcucha między próbami wymiany: max(ROUND_MOVES, 10 n). Runda musi
+// być dużo dłuższa od wybudzenia puli, a zarazem na tyle krótka, by stany zdążyły
+// wędrować po drabinie.
+const int ROUND_MOVES = 10000;
+
+}
+
+ParallelTempering::ParallelTempering(const Adjacency_Matrix& graph, double time, int replicas, uint64_t seed) : rng(seed) {
+    matrix = graph.getView();
+    size = matrix.size();
+    timeBound = time;
+    neighborhood = Neighborhood(matrix, NeighborhoodKind::FullSwap);
+
+    const int count = std::max(1, replicas);
+    top = estimateInitialTemperature(matrix, rng);
+    temperatures.resize(count);
+    setLadder(top / INITIAL_SPAN);
+    chains.resize(count);
+    holder.resize(count);
+    for (int c = 0; c < count; c++) {
+        chains[c].rng.reseed(rng());
+        chains[c].rung = c;
+        holder[c] = c;
+    }
+}
+
+ParallelTempering::~ParallelTempering() {
+}
+
+// Drabina geometryczna od top do coldest: T_k = top * (coldest / top)^(k / (M - 1)).
+void ParallelTempering::setLadder(double coldest) {
+    const int count = (int)temperatures.size();
+    for (int k = 0; k < count; k++) {
+        temperatures[k] = count > 1 ? top * std::pow(coldest / top, (double)k / (count - 1)) : top;
+    }
+}
+
+void ParallelTempering::setThreads(int threads) {
+    threads = std::min(threads, (int)chains.size());
+    pool.reset(threads > 1 ? new WorkerPool(threads) : nullptr);
+}
+
+void ParallelTempering::setNeighborhood(const Neighborhood& moves) {
+    neighborhood = moves.rebind(matrix);
+}
+
+void ParallelTempering::setPolish(std::shared_ptr<const CandidateLists> lists) {
+    polish.reset(new LocalSearch(matrix, lists));
+}
+
+// Jedna runda łańcucha w jego bieżącej temperaturze. Łańcuch zapisuje tylko własny stan,
+// a trasę kopiuje do best tylko wtedy, gdy pobije najlepszy koszt znany na początku rundy.
+// Nic nie jest alokowane - łańcuch pracuje na buforach z początku przebiegu.
+void ParallelTempering::advance(Chain& chain, int moves) const {
+    const double inverseTemperature = 1.0 / temperatures[chain.rung];
+    int cost = chain.cost;
+    int bestCost = chain.bestCost;
+    bool currentIsBest = false; // Bieżąca trasa jest lepsza od zapisanej w best.
+    long long accepted = 0;
+    long long uphill = 0;
+    long long climbs = 0;
+    for (int i = 0; i < moves; i++) {
+        Move move = neighborhood.randomMove(chain.path, chain.position, chain.rng);
+        uphill += move.delta > 0;
+        if (metropolisAccept(move.delta, inverseTemperature, chain.rng)) {
+            // Kopia dopiero przy opuszczaniu najlepszej trasy, jak w SimulatedAnnealing.
+            if (currentIsBest && move.delta >= 0) {
+                std::copy(chain.path.begin(), chain.path.end(), chain.best.begin());
+                currentIsBest = false;
+            }
+            Neighborhood::apply(move, chain.path, chain.position);
+            cost += move.delta;
+            accepted++;
+            climbs += move.delta > 0;
+            if (cost < bestCost) {
+                bestCost = cost;
+                currentIsBest = true;
+            }
+        }
+    }
+    if (currentIsBest) {
+        std::copy(chain.path.begin(), chain.path.end(), chain.best.begin());
+    }
+    chain.cost = cost;
+    chain.bestCost = bestCost;
+    chain.accepted = accepted;
+    chain.uphill = uphill;
+    chain.climbs = climbs;
+}
+
+// Próby wymiany stanów w parach temperatur (k, k+1) dla k o parzystości parity; pary
+// naprzemiennie parzyste i nieparzyste nie nakładają się. Zamiana jest przyjmowana
+// z prawdopodobieństwem min(1, exp((1/T_k - 1/T_k+1) (E_k - E_k+1))), czyli zawsze,
+// gdy gorętszy łańcuch ma krótszą trasę. Zwraca liczbę przyjętych zamian.
+long long ParallelTempering::exchange(int parity) {
+    long long swaps = 0;
+    for (int k = parity; k + 1 < (int)holder.size(); k += 2) {
+        Chain& hot = chains[holder[k]];
+        Chain& cold = chains[holder[k + 1]];
+        const double delta = (1.0 / temperatures[k + 1] - 1.0 / temperatures[k]) * (double)(hot.cost - cold.cost);
+        if (metropolisAccept(delta, 1.0, rng)) {
+            std::swap(holder[k], holder[k + 1]);
+            hot.rung = k + 1;
+            cold.rung = k;
+            swaps++;
+        }
+    }
+    return swaps;
+}
+
+// Wszystkie łańcuchy startują z trasy zachłannej; gorące szybko się od niej oddalają,
+// a ich stany schodzą po drabinie przez wymiany. Po każdej rundzie dół drabiny jest
+// przesuwany tak, by najzimniejszy łańcuch przyjmował ok. COLD_ACCEPTANCE ruchów pod górę.
+// Czas liczony jest zegarem ściennym sprawdzanym między rundami.
+Tour ParallelTempering::solve(const SearchContext& context) {
+    Deadline deadline(timeBound, context.stop);
+    Tour result;
+    result.path = bestGreedyTour(matrix, pool.get());
+    result.cost = tourCost(matrix, result.path);
+    for (Chain& chain : chains) {
+        chain.path = result.path;
+        chain.best = result.path;
+        Neighborhood::indexPositions(chain.path, chain.position);
+        chain.cost = result.cost;
+    }
+    const int moves = std::max(ROUND_MOVES, 10 * size);
+    const int count = (int)chains.size();
+    PeriodicTimer snapshotTimer(context.telemetry != nullptr ? context.telemetry->interval() : 0); // Migawki.
+    int parity = 0;
+    stats = SolverStats();
+    stats.improved(0, result.cost);
+    if (context.globalBest != nullptr) {
+        context.globalBest->offer(result.path, result.cost, 0);
+    }
+
+    const std::function<void(int)> round = [&](int c) { advance(chains[c], moves); };
+    const long long allocationBase = allocationCount(); // Alokacje sprzed pętli głównej nie są liczone.
+
+    while (true) {
+        for (Chain& chain : chains) {
+            chain.bestCost = result.cost;
+        }
+        if (pool != nullptr) {
+            pool->run(count, round);
+        } else {
+            for (Chain& chain : chains) {
+                advance(chain, moves);
+            }
+        }
+        result.evaluations += (long long)count * moves;
+        if (TELEMETRY_ENABLED) {
+            stats.iterations = result.evaluations;
+            for (const Chain& chain : chains) {
+                stats.accepted += chain.accepted;
+            }
+        }
+
+        // Najlepsza trasa rundy (łańcuch, który najbardziej poprawił wynik).
+        const Chain* leader = &chains[0];
+        for (const Chain& chain : chains) {
+            if (chain.bestCost < leader->bestCost) {
+                leader = &chain;
+            }
+        }
+        if (leader->bestCost < result.cost) {
+            std::copy(leader->best.begin(), leader->best.end(), result.path.begin());
+            result.cost = leader->bestCost;
+            result.foundTime = deadline.elapsed();
+            stats.improved(result.foundTime, result.cost);
+            if (context.globalBest != nullptr) {
+                context.globalBest->offer(result.path, result.cost, result.foundTime);
+            }
+        }
+
+        // Dopasowanie dołu drabiny: stała rozpiętość bywa na jednej instancji za gorąca
+        // (najzimniejszy łańcuch nie schodzi do minimum), a na innej za zimna (zamarza).
+        const Chain& cold = chains[holder.back()];
+        const double climbRate = cold.uphill > 0 ? (double)cold.climbs / cold.uphill : 0;
+        const double coldest = climbRate > COLD_ACCEPTANCE ? temperatures.back() / COLD_STEP
+                                                           : temperatures.back() * COLD_STEP;
+        setLadder(std::min(coldest, top));
+
+        const long long swaps = exchange(parity);
+        parity ^= 1;
+        if (TELEMETRY_ENABLED) {
+            stats.exchanges += swaps;
+            stats.temperature = temperatures.back();
+        }
+
+        // Okresowa migawka statystyk przebiegu (bieżący koszt - łańcuch najzimniejszy).
+        if (TELEMETRY_ENABLED && context.telemetry != nullptr && snapshotTimer.due(deadline.elapsed())) {
+            stats.evaluations = result.evaluations;
+            stats.rejected = result.evaluations - stats.accepted;
+            stats.allocations = allocationCount() - allocationBase;
+            context.telemetry->snapshot("pt", context.island, deadline.elapsed(), stats,
+                                        chains[holder.back()].cost, result.cost);
+        }
+
+        if (deadline.reached() || context.budgetSpent(result.evaluations)) {
+            break;
+        }
+    }
+
+    if (polish != nullptr && polish->polish(result.path, result.cost)) {
+        result.foundTime = deadline.elapsed();
+        stats.improved(result.foundTime, result.cost);
+        if (context.globalBest != nullptr) {
+            context.globalBest->offer(result.path, result.cost, result.foundTime);
+        }
+    }
+    if (TELEMETRY_ENABLED && context.telemetry != nullptr) {
+        stats.evaluations = result.evaluations;
+        stats.rejected = result.evaluations - stats.accepted;
+        stats.allocations = allocationCount() - allocationBase;
+        context.telemetry->finish("pt", context.island, deadline.elapsed(), stats, result.cost);
+    }
+    return result;
+}
@@ -0,0 +1,63 @@
+#ifndef PEA2_PARALLEL_TEMPERING_H
+#define PEA2_PARALLEL_TEMPERING_H
+
+#include "adjacency_matrix.h"
+#include "LocalSearch.h"
+#include "Neighborhood.h"
+#include "SearchContext.h"
+#include "WorkerPool.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+// Wymiana replik (parallel tempering): M łańcuchów SA w temperaturach tworzących ciąg
+// geometryczny od temperatury początkowej SA (estimateInitialTemperature) w dół.
+// Łańcuchy wykonują rundy ruchów równolegle na puli wątków, a między rundami łańcuchy
+// w sąsiednich temperaturach próbują zamienić się stanami według kryterium Metropolisa.
+// Zamieniane są tylko przypisania temperatur, więc każdy łańcuch zachowuje własne bufory
+// trasy przydzielone raz na początku przebiegu. Macierz jest współdzielona tylko do odczytu.
+class ParallelTempering {
+public:
+    ParallelTempering(const Adjacency_Matrix& graph, double time, int replicas, uint64_t seed = std::random_device()());
+    ~ParallelTempering();
+    Tour solve(const SearchContext& context = SearchContext());
+    void setThreads(int threads); // Wątki obsługujące łańcuchy (domyślnie 1 - łańcuchy po kolei).
+    void setNeighborhood(const Neighborhood& moves); // Domyślnie losowa zamiana dowolnych dwóch pozycji.
+    void setPolish(std::shared_ptr<const CandidateLists> lists); // Szlifowanie trasy końcowej.
+    const std::vector<double>& ladder() const { return temperatures; } // Od najwyższej temperatury.
+    const SolverStats& statistics() const { return stats; }
+private:
+    // Stan jednego łańcucha. Wyrównanie do linii pamięci podręcznej, bo łańcuchy
+    // sąsiadujące w wektorze są zapisywane przez różne wątki.
+    struct alignas(64) Chain {
+        std::vector<int> path;
+        std::vector<int> position; // Pozycje wierzchołków w path.
+        std::vector<int> best;     // Trasa lepsza od najlepszej znanej na początku rundy.
+        int cost = 0;
+        int bestCost = 0;
+        int rung = 0;              // Indeks temperatury w drabinie.
+        long long accepted = 0;    // Przyjęte ruchy w ostatniej rundzie.
+        long long uphill = 0;      // Zaproponowane w ostatniej rundzie ruchy pod górę
+        long long climbs = 0;      // i przyjęte spośród nich.
+        Random rng;
+    };
+
+    MatrixView matrix; // Widok na macierz grafu; graf musi żyć dłużej niż solver.
+    int size;
+    double timeBound;
+    double top; // Najwyższa temperatura (początkowa temperatura SA).
+    std::vector<double> temperatures;
+    std::vector<Chain> chains;
+    std::vector<int> holder; // holder[k] - łańcuch w temperaturze temperatures[k].
+    Neighborhood neighborhood;
+    std::unique_ptr<WorkerPool> pool;
+    std::unique_ptr<LocalSearch> polish;
+    SolverStats stats;
+    Random rng; // Strumień dla prób wymiany (łańcuchy mają własne).
+
+    void setLadder(double coldest);
+    void advance(Chain& chain, int moves) const;
+    long long exchange(int parity);
+};
+
+#endif // PEA2_PARALLEL_TEMPERING_H
@@ -0,0 +1,78 @@
+#ifndef PEA2_RANDOM_H
+#define PEA2_RANDOM_H
+
+#include <cstdint>
+#include <limits>
+
+// Szybki generator xoshiro256** z własnym stanem dla każdego solvera (bez globalnej
+// blokady jak w rand()). Ziarno rozwijane jest przez splitmix64, więc te same ziarno
+// daje ten sam ciąg liczb. Spełnia wymagania UniformRandomBitGenerator (std::shuffle).
+class Random {
+public:
+    typedef uint64_t result_type;
+
+    explicit Random(uint64_t seed = 0) {
+        reseed(seed);
+    }
+
+    void reseed(uint64_t seed) {
+        for (uint64_t& word : state) {
+            seed += 0x9e3779b97f4a7c15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Stan generatora do zapisu w pliku stanu przebiegu i do jego odtworzenia.
+    void save(uint64_t words[4]) const {
+        for (int i = 0; i < 4; i++) words[i] = state[i];
+    }
+    void restore(const uint64_t words[4]) {
+        for (int i = 0; i < 4; i++) state[i] = words[i];
+    }
+
+    // Liczba całkowita z przedziału [0, bound) bez obciążenia (metoda Lemire'a).
+    uint32_t below(uint32_t bound) {
+        uint64_t product = (uint64_t)(uint32_t)((*this)() >> 32) * bound;
+        uint32_t low = (uint32_t)product;
+        if (low < bound) {
+            const uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = (uint64_t)(uint32_t)((*this)() >> 32) * bound;
+                low = (uint32_t)product;
+            }
+        }
+        return (uint32_t)(product >> 32);
+    }
+
+    // Liczba rzeczywista z przedziału [0, 1) z 53 losowymi bitami.
+    double uniform() {
+        return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+#endif // PEA2_RANDOM_H
@@ -0,0 +1,119 @@
+#ifndef PEA2_SEARCH_CONTEXT_H
+#define PEA2_SEARCH_CONTEXT_H
+
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Anytime.h"
+#include "Deadline.h"
+#include "Telemetry.h"
+
+// Wynik pojedynczego przebiegu solvera.
+struct Tour {
+    std::vector<int> path;
+    int cost = INT_MAX;
+    double foundTime = 0; // Sekundy od startu przebiegu.
+    long long evaluations = 0; // Liczba ocenionych ruchów (sąsiadów) w całym przebiegu.
+};
+
+// Globalnie najlepsza trasa współdzielona przez wątki. Publikacja podmienia niezmienny
+// obiekt Tour przez compare-and-swap, a koszt jest dostępny bez blokad do szybkiego
+// odrzucania gorszych kandydatów. Opcjonalny AnytimeWriter dostaje każdą poprawę.
+class SharedBest {
+public:
+    // Zwraca true, jeśli trasa poprawiła globalnie najlepszy wynik.
+    bool offer(const std::vector<int>& path, int cost, double foundTime) {
+        if (cost >= bestCost.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        auto candidate = std::make_shared<const Tour>(Tour{path, cost, foundTime});
+        std::shared_ptr<const Tour> current = std::atomic_load(&best);
+        while (current == nullptr || cost < current->cost) {
+            if (std::atomic_compare_exchange_weak(&best, &current, candidate)) {
+                int seen = bestCost.load(std::memory_order_relaxed);
+                while (cost < seen && !bestCost.compare_exchange_weak(seen, cost, std::memory_order_relaxed)) {
+                }
+                if (anytime != nullptr) {
+                    anytime->publish(path, cost, foundTime);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+    int cost() const {
+        return bestCost.load(std::memory_order_relaxed);
+    }
+    std::shared_ptr<const Tour> snapshot() const {
+        return std::atomic_load(&best);
+    }
+    void setAnytime(AnytimeWriter* writer) { // Ustawiane przed startem wątków.
+        anytime = writer;
+    }
+private:
+    std::shared_ptr<const Tour> best;
+    AnytimeWriter* anytime = nullptr;
+    std::atomic<int> bestCost{INT_MAX};
+};
+
+// Pierścień wysp: każda wyspa oddaje swoją elitę następnej i odbiera trasę od poprzedniej.
+// Migracje są rzadkie, więc skrzynki chroni zwykły mutex.
+class IslandRing {
+public:
+    explicit IslandRing(int islands) : inbox(islands) {
+    }
+    // Wysyła elitę wyspy island i odbiera oczekującą u niej trasę (zwraca false, jeśli brak).
+    bool exchange(int island, const Tour& elite, Tour& incoming) {
+        Slot& next = inbox[(island + 1) % inbox.size()];
+        {
+            std::lock_guard<std::mutex> lock(next.mutex);
+            if (elite.cost < next.tour.cost) {
+                next.tour = elite;
+            }
+        }
+        Slot& own = inbox[island];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (own.tour.path.empty()) {
+            return false;
+        }
+        incoming = std::move(own.tour);
+        own.tour = Tour();
+        return true;
+    }
+private:
+    struct Slot {
+        std::mutex mutex;
+        Tour tour;
+    };
+    std::vector<Slot> inbox;
+};
+
+// Otoczenie przebiegu solvera uruchomionego przez sterownik równoległy. Domyślny
+// kontekst (bez globalnego wyniku i bez wysp) odpowiada zwykłemu przebiegowi.
+struct SearchContext {
+    SharedBest* globalBest = nullptr;
+    IslandRing* islands = nullptr;
+    int island = 0;
+    double migrationInterval = 1.0; // Sekundy między migracjami.
+    const std::atomic<bool>* stop = nullptr; // Ustawiona z zewnątrz kończy przebieg przed czasem.
+    TelemetrySink* telemetry = nullptr; // Odbiorca migawek postępu (island jest wtedy numerem wątku).
+    long long evaluationLimit = 0; // > 0 - przebieg kończy się także po tylu ocenionych ruchach.
+
+    bool budgetSpent(long long evaluations) const {
+        return evaluationLimit > 0 && evaluations >= evaluationLimit;
+    }
+
+    // Migracja w modelu wyspowym: gdy minął termin, oddaje najlepszą trasę wyspy sąsiadowi
+    // i zwraca true, jeśli odebrany imigrant jest lepszy od bieżącego rozwiązania (currentCost).
+    bool receiveImmigrant(PeriodicTimer& migration, double elapsed, const std::vector<int>& best, int bestCost,
+                          double foundTime, int currentCost, Tour& incoming) const {
+        if (islands == nullptr || !migration.due(elapsed)) {
+            return false;
+        }
+        return islands->exchange(island, Tour{best, bestCost, foundTime}, incoming) && incoming.cost < currentCost;
+    }
+};
+
+#endif // PEA2_SEARCH_CONTEXT_H
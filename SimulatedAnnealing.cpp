@@ -1,204 +1,359 @@
-#include "SimulatedAnnealing.h"
-#include <algorithm>
-#include <ctime>
-#include <iostream>
-#include <cmath>
-#include <random>
-#include <climits>
-
-using namespace std;
-
-// Konstruktor klasy SimulatedAnnealing.
-SimulatedAnnealing::SimulatedAnnealing(Adjacency_Matrix& graph, int time, double rate) {
-    matrix = graph.getMatrix(); // Pobranie macierzy sąsiedztwa z grafu.
-    size = matrix.size();       // Ustalenie liczby wierzchołków.
-    timeBound = time;           // Ustawienie maksymalnego czasu działania.
-    coolingRate = rate;         // Ustawienie współczynnika schładzania.
-    temperatureBuffer = calculateTemperature(); // Obliczenie początkowej temperatury.
-    numVertices = graph.getNumVertices();       // Ustalenie liczby wierzchołków.
-    std::vector<int> initialPath = greedyPath(); // Wygenerowanie początkowej ścieżki.
-}
-
-// Główna metoda algorytmu apply.
-void SimulatedAnnealing::apply() {
-    int numberOfIterations = 1000; // Liczba iteracji na każdym poziomie temperatury.
-    best = greedyPath();            // Ustalenie początkowej ścieżki.
-    vector<int> currentSolution = best; // Aktualna rozpatrywana ścieżka.
-    int bestCost = calculatePath(best); // Koszt najlepszej ścieżki.
-    int currentCost = bestCost;         // Koszt aktualnej ścieżki.
-    double temperature = temperatureBuffer; // Aktualna temperatura.
-    double time = 0;                       // Czas działania algorytmu.
-    double foundTime = 0;                  // Czas znalezienia najlepszego rozwiązania.
-    std::clock_t start;                    // Początek pomiaru czasu.
-    start = std::clock();
-
-    // Główna pętla algorytmu.
-    while (true) {
-        while (temperature > 0.1) { // Dopóki temperatura jest wystarczająco wysoka.
-            for (int i = 0; i < numberOfIterations; i++) {
-                // Generowanie nowego rozwiązania.
-                vector<int> newSolution = currentSolution;
-                int pos1 = rand() % numVertices;
-                int pos2 = rand() % numVertices;
-                swap(currentSolution[pos1], currentSolution[pos2]);
-                int newCost = calculatePath(currentSolution);
-
-                // Decyzja o akceptacji nowego rozwiązania.
-                if (newCost < currentCost || exp((currentCost - newCost) / temperature) > ((double)rand() / RAND_MAX)) {
-                    currentCost = newCost;
-                } else {
-                    swap(currentSolution[pos1], currentSolution[pos2]); // Przywrócenie poprzedniego stanu.
-                }
-
-                // Aktualizacja najlepszego rozwiązania.
-                if (currentCost < bestCost) {
-                    best = currentSolution;
-                    bestCost = currentCost;
-                }
-            }
-
-            // Obniżanie temperatury.
-            temperature *= coolingRate;
-            time = (std::clock() - start) / (double)CLOCKS_PER_SEC; // Aktualizacja czasu działania.
-
-            // Sprawdzenie warunku zakończenia.
-            if (time >= timeBound) {
-                cout << "Droga: ";
-                std::ofstream file("wynikiSA.txt");
-                for (int d = 0; d < size; d++) {
-                    cout << best[d] << " ";
-                    file << best[d] << " "; // Zapis do pliku.
-                }
-                cout << "\nKoszt: " << bestCost << endl;
-                cout << "Znaleziono po: " << foundTime << " s " << endl;
-                cout << "Temperatura koncowa: " << temperature << endl;
-                cout << "Wartosc wyrazenia e^(-1/Tk): " << exp(-1/temperature);
-                cout << endl;
-                return; // Zakończenie algorytmu.
-            }
-        }
-        temperature = temperatureBuffer; // Resetowanie temperatury.
-    }
-}
-
-// Generuje losową permutację wierzchołków grafu.
-std::vector<int> SimulatedAnnealing::random_permutation(int _size) {
-    std::vector<int> temp;
-    temp.reserve(_size);
-    for (int i = 0; i < _size; i++) {
-        temp.push_back(i);
-    }
-    std::random_device rd; // Inicjalizacja generatora liczb losowych.
-    std::mt19937 g(rd());  // Generator liczb losowych.
-    std::shuffle(temp.begin(), temp.end(), g); // Mieszanie permutacji.
-    return temp;
-}
-
-// Oblicza początkową temperaturę dla algorytmu Symulowanego Wyżarzania.
-double SimulatedAnnealing::calculateTemperature() {
-    vector<int> origin; // Wektor przechowujący oryginalną permutację wierzchołków.
-    int firstToSwap, secondToSwap; // Indeksy wierzchołków do zamiany.
-    int delta = 0, buffer = 0; // Zmienne do obliczania średniej różnicy kosztów.
-
-    // Pętla wykonująca się określoną liczbę razy do obliczenia średniej różnicy kosztów.
-    for (int i = 0; i < 10000; i++) {
-        // Losowe wybieranie dwóch różnych wierzchołków do zamiany.
-        do {
-            firstToSwap = rand() % size;
-            secondToSwap = rand() % size;
-        } while (firstToSwap == secondToSwap); // Zapewnienie, że wierzchołki są różne.
-
-        origin = random_permutation(size); // Generowanie losowej permutacji wierzchołków.
-        vector<int> neighbour(origin); // Tworzenie kopii permutacji.
-        std::swap(neighbour[firstToSwap], neighbour[secondToSwap]); // Zamiana wierzchołków.
-
-        // Obliczanie różnicy kosztów między oryginalną a zmodyfikowaną permutacją.
-        delta = fabs(calculatePath(origin) - calculatePath(neighbour));
-        buffer += delta; // Dodawanie różnicy do bufora.
-    }
-
-    buffer /= 10000; // Obliczenie średniej różnicy kosztów.
-
-    // Obliczenie początkowej temperatury na podstawie średniej różnicy kosztów.
-    // Używamy wzoru z teorii Symulowanego Wyżarzania.
-    return (-1 * buffer) / log(0.99);
-}
-
-// Oblicza koszt danej ścieżki w grafie.
-int SimulatedAnnealing::calculatePath(vector<int> path) {
-    int cost = 0;
-    for (int i = 0; i < path.size() - 1; ++i) {
-        cost += matrix[path[i]][path[i + 1]]; // Dodawanie kosztu krawędzi.
-    }
-    cost += matrix[path[size - 1]][path[0]]; // Dodanie kosztu powrotu do punktu startowego.
-    return cost;
-}
-
-
-// Generuje początkową ścieżkę metodą zachłanną.
-std::vector<int> SimulatedAnnealing::greedyPath() {
-    std::vector<int> path;
-    std::vector<bool> visited(size, false);
-    int current = 0; // Start z pierwszego wierzchołka.
-    path.push_back(current);
-    visited[current] = true;
-    int totalCost = 0;
-    for (int i = 1; i < size; ++i) {
-        int nearest = -1;
-        int minDistance = INT_MAX;
-        // Szukanie najbliższego nieodwiedzonego wierzchołka.
-        for (int j = 0; j < size; ++j) {
-            if (!visited[j] && matrix[current][j] < minDistance) {
-                nearest = j;
-                minDistance = matrix[current][j];
-            }
-        }
-        // Dodanie wierzchołka do ścieżki.
-        if (nearest != -1) {
-            path.push_back(nearest);
-            visited[nearest] = true;
-            totalCost += minDistance;
-            current = nearest;
-        }
-    }
-    totalCost += matrix[current][path[0]]; // Dodanie kosztu powrotu do startu.
-    // Print the greedy path and its total cost
-    std::cout << "Greedy Path: ";
-    for (int node : path) {
-        std::cout << node << " ";
-    }
-    std::cout << "\nTotal Cost of Greedy Path: " << totalCost << std::endl;
-    return path;
-}
-
-// Zapisuje najlepszą ścieżkę do pliku.
-void SimulatedAnnealing::savePathToFile() {
-    std::ofstream file("wynikiSA.txt");
-    if (file.is_open()) {
-        for (int node : best) {
-            file << node << " "; // Zapis każdego wierzchołka do pliku.
-        }
-        file.close();
-    } else {
-        std::cerr << "Nie można otworzyć pliku do zapisu: wynikiSA.txt" << std::endl;
-    }
-}
-
-// Wczytuje ścieżkę z pliku i zwraca ją jako wektor.
-std::vector<int> SimulatedAnnealing::loadPathFromFile(const std::string& filename) {
-    std::vector<int> path;
-    std::ifstream file(filename);
-    int node;
-    if (file.is_open()) {
-        while (file >> node) {
-            path.push_back(node); // Wczytywanie wierzchołków do ścieżki.
-        }
-        file.close();
-    } else {
-        std::cerr << "Nie można otworzyć pliku do odczytu: " << filename << std::endl;
-    }
-    return path;
-}
-SimulatedAnnealing::~SimulatedAnnealing()
-{
-}
+#include "SimulatedAnnealing.h"
+#include "AllocationCounter.h"
+#include "Greedy.h"
+#include "Metropolis.h"
+#include "Moves.h"
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <climits>
+
+using namespace std;
+
+// Konstruktor klasy SimulatedAnnealing.
+SimulatedAnnealing::SimulatedAnnealing(const Adjacency_Matrix& graph, double time, double rate, uint64_t seed) : rng(seed) {
+    matrix = graph.getView(); // Widok na macierz sąsiedztwa grafu (bez kopiowania).
+    size = matrix.size();       // Ustalenie liczby wierzchołków.
+    timeBound = time;           // Ustawienie maksymalnego czasu działania.
+    coolingRate = rate;         // Ustawienie współczynnika schładzania.
+    temperatureBuffer = calculateTemperature(); // Obliczenie początkowej temperatury.
+    numVertices = graph.getNumVertices();       // Ustalenie liczby wierzchołków.
+    neighborhood = Neighborhood(matrix, NeighborhoodKind::FullSwap); // Domyślnie losowa zamiana pozycji.
+}
+
+// Uruchamia algorytm i wypisuje wynik.
+void SimulatedAnnealing::apply() {
+    // Print the greedy path and its total cost
+    std::vector<int> greedy = greedyPath();
+    std::cout << "Greedy Path: ";
+    for (int node : greedy) {
+        std::cout << node << " ";
+    }
+    std::cout << "\nTotal Cost of Greedy Path: " << calculatePath(greedy) << std::endl;
+    Tour result = solve();
+    cout << "Droga: ";
+    std::ofstream file("wynikiSA.txt");
+    for (int d = 0; d < size; d++) {
+        cout << result.path[d] << " ";
+        file << result.path[d] << " "; // Zapis do pliku.
+    }
+    cout << "\nKoszt: " << result.cost << endl;
+    cout << "Znaleziono po: " << result.foundTime << " s " << endl;
+    cout << "Temperatura koncowa: " << finalTemperature << endl;
+    cout << "Wartosc wyrazenia e^(-1/Tk): " << exp(-1/finalTemperature);
+    cout << endl;
+}
+
+// Główna metoda algorytmu. Czas liczony jest zegarem ściennym (Deadline), aby przy wielu
+// wątkach limit timeBound oznaczał rzeczywisty czas działania.
+Tour SimulatedAnnealing::solve(const SearchContext& context) {
+    best = initialTour.empty() ? greedyPath() : initialTour; // Ustalenie początkowej ścieżki.
+    vector<int> currentSolution = best; // Aktualna rozpatrywana ścieżka.
+    vector<int> position; // Pozycje wierzchołków w currentSolution.
+    int bestCost = calculatePath(best); // Koszt najlepszej ścieżki.
+    AnnealingSchedule annealing(schedule, temperatureBuffer, coolingRate, size); // Temperatura i długość epok.
+    ElitePool elite; // Najlepsze trasy przebiegu - punkty startowe po podgrzaniu.
+    elite.offer(best, bestCost);
+    double foundTime = 0;                  // Czas znalezienia najlepszego rozwiązania (od wznowienia).
+    long long evaluations = 0;             // Liczba ocenionych ruchów.
+    long long resumedEvaluations = 0;      // Ruchy ocenione przed wznowieniem (tylko do zapisu stanu).
+    if (resumed != nullptr) {
+        restoreState(*resumed, currentSolution, bestCost, resumedEvaluations, annealing, elite);
+        resumed.reset();
+    }
+    Neighborhood::indexPositions(currentSolution, position);
+    int currentCost = calculatePath(currentSolution); // Koszt aktualnej ścieżki.
+    bool currentIsBest = false;         // Bieżąca ścieżka jest lepsza od zapisanej w best.
+    PeriodicTimer checkpointTimer(checkpointInterval); // Okresowy zapis stanu.
+    PeriodicTimer migrationTimer(context.migrationInterval); // Wymiana z sąsiednią wyspą.
+    PeriodicTimer polishTimer(polishInterval); // Szlifowanie najlepszej trasy.
+    Deadline deadline(timeBound, context.stop); // Limit czasu ściennego.
+    PeriodicTimer snapshotTimer(context.telemetry != nullptr ? context.telemetry->interval() : 0); // Migawki.
+    stats = SolverStats();
+    stats.improved(0, bestCost);
+    if (context.globalBest != nullptr) {
+        context.globalBest->offer(best, bestCost, 0);
+    }
+
+    const long long allocationBase = allocationCount(); // Alokacje sprzed pętli głównej nie są liczone.
+
+    // Główna pętla algorytmu: jedna epoka (poziom temperatury) na obrót.
+    while (true) {
+        bool improved = false;
+        const double temperature = annealing.temperature();
+        const double inverseTemperature = 1.0 / temperature;
+        const int epochLength = annealing.epochLength();
+        long long acceptedMoves = 0; // Przyjęte ruchy w epoce (do adaptacji harmonogramu).
+        for (int i = 0; i < epochLength; i++) {
+            // Generowanie nowego rozwiązania: losowy ruch z wybranego sąsiedztwa.
+            // Koszt sąsiada liczony z samych krawędzi zmienionych przez ruch.
+            Move move = neighborhood.randomMove(currentSolution, position, rng);
+
+            // Decyzja o akceptacji nowego rozwiązania.
+            if (accept(move.delta, inverseTemperature)) {
+                // Najlepsza trasa kopiowana jest dopiero wtedy, gdy bieżąca ma ją opuścić;
+                // kolejne poprawy w czasie spadku nie kopiują nic.
+                if (currentIsBest && move.delta >= 0) {
+                    best = currentSolution;
+                    currentIsBest = false;
+                }
+                Neighborhood::apply(move, currentSolution, position);
+                currentCost += move.delta;
+                acceptedMoves++;
+
+                // Aktualizacja najlepszego rozwiązania.
+                if (currentCost < bestCost) {
+                    bestCost = currentCost;
+                    currentIsBest = true;
+                    improved = true;
+                }
+            }
+        }
+        if (currentIsBest) {
+            best = currentSolution;
+            currentIsBest = false;
+        }
+
+        evaluations += epochLength;
+        if (TELEMETRY_ENABLED) {
+            stats.iterations = evaluations;
+            stats.accepted += acceptedMoves;
+            stats.temperature = temperature;
+        }
+        if (improved) {
+            foundTime = deadline.elapsed();
+            stats.improved(foundTime, bestCost);
+            elite.offer(best, bestCost);
+            if (context.globalBest != nullptr) {
+                context.globalBest->offer(best, bestCost, foundTime);
+            }
+        }
+
+        // Obniżenie temperatury; po zamarznięciu lub stagnacji - ponowne podgrzanie i restart
+        // z najlepszej albo elitarnej trasy, przy stagnacji dodatkowo zaburzonej.
+        const double progress = timeBound > 0 ? deadline.lastElapsed() / timeBound : 1.0;
+        AnnealingSchedule::Action action = annealing.endEpoch(acceptedMoves, epochLength, improved, progress);
+        if (action != AnnealingSchedule::Action::Continue) {
+            if (TELEMETRY_ENABLED) stats.restarts++;
+            if (schedule.restart != RestartPolicy::Continue) {
+                currentSolution = schedule.restart == RestartPolicy::Elite ? elite.pick(rng) : best;
+                if (action == AnnealingSchedule::Action::Diversify) {
+                    doubleBridgeKick(currentSolution, 1 + size / 100, rng);
+                }
+                Neighborhood::indexPositions(currentSolution, position);
+                currentCost = calculatePath(currentSolution);
+            }
+        }
+
+        // Model wyspowy: oddanie najlepszej trasy sąsiadowi i przejęcie lepszego imigranta.
+        Tour incoming;
+        if (context.receiveImmigrant(migrationTimer, deadline.lastElapsed(), best, bestCost, foundTime, currentCost,
+                                     incoming)) {
+            currentSolution = incoming.path;
+            Neighborhood::indexPositions(currentSolution, position);
+            currentCost = incoming.cost;
+            if (currentCost < bestCost) {
+                best = currentSolution;
+                bestCost = currentCost;
+                stats.improved(deadline.lastElapsed(), bestCost);
+                elite.offer(best, bestCost);
+            }
+        }
+
+        // Okresowe szlifowanie najlepszej trasy; bieżące rozwiązanie pozostaje bez zmian.
+        if (polish != nullptr && polishTimer.due(deadline.lastElapsed())) {
+            if (polishBest(best, bestCost, foundTime, deadline, true, context)) {
+                elite.offer(best, bestCost);
+            }
+        }
+
+        // Okresowa migawka statystyk przebiegu.
+        if (TELEMETRY_ENABLED && context.telemetry != nullptr && snapshotTimer.due(deadline.lastElapsed())) {
+            stats.evaluations = evaluations;
+            stats.rejected = evaluations - stats.accepted;
+            stats.allocations = allocationCount() - allocationBase;
+            context.telemetry->snapshot("sa", context.island, deadline.lastElapsed(), stats, currentCost, bestCost);
+        }
+
+        // Okresowy zapis stanu przebiegu (po epoce best i currentSolution są spójne).
+        if (!checkpointPath.empty() && checkpointTimer.due(deadline.lastElapsed())) {
+            saveState(currentSolution, bestCost, resumedEvaluations + evaluations, annealing, elite);
+        }
+
+        // Sprawdzenie warunku zakończenia.
+        if (deadline.expired() || context.budgetSpent(evaluations)) {
+            finalTemperature = annealing.temperature();
+            if (polish != nullptr) {
+                polishBest(best, bestCost, foundTime, deadline, false, context);
+            }
+            if (!checkpointPath.empty()) {
+                saveState(currentSolution, bestCost, resumedEvaluations + evaluations, annealing, elite);
+            }
+            if (TELEMETRY_ENABLED && context.telemetry != nullptr) {
+                stats.evaluations = evaluations;
+                stats.rejected = evaluations - stats.accepted;
+                stats.allocations = allocationCount() - allocationBase;
+                context.telemetry->finish("sa", context.island, deadline.elapsed(), stats, bestCost);
+            }
+            return Tour{best, bestCost, foundTime, evaluations}; // Zakończenie algorytmu.
+        }
+    }
+}
+
+// Kryterium Metropolisa z tablicą progów (Metropolis.h).
+bool SimulatedAnnealing::accept(int delta, double inverseTemperature) {
+    return metropolisAccept(delta, inverseTemperature, rng);
+}
+
+// Oblicza początkową temperaturę dla algorytmu Symulowanego Wyżarzania (AnnealingSchedule.h).
+double SimulatedAnnealing::calculateTemperature() {
+    return estimateInitialTemperature(matrix, rng);
+}
+
+// Oblicza koszt danej ścieżki w grafie (Moves.h).
+int SimulatedAnnealing::calculatePath(const std::vector<int>& path) const {
+    return tourCost(matrix, path);
+}
+
+
+// Generuje początkową ścieżkę metodą zachłanną: najlepszą z tras najbliższego sąsiada
+// z wielu startów (Greedy.h). Trasa zależy tylko od macierzy, więc liczona jest raz
+// i używana ponownie przez apply() i kolejne przebiegi.
+std::vector<int> SimulatedAnnealing::greedyPath() {
+    if (greedy.empty()) {
+        greedy = bestGreedyTour(matrix);
+    }
+    return greedy;
+}
+
+// Zapisuje najlepszą ścieżkę do pliku.
+void SimulatedAnnealing::savePathToFile() {
+    std::ofstream file("wynikiSA.txt");
+    if (file.is_open()) {
+        for (int node : best) {
+            file << node << " "; // Zapis każdego wierzchołka do pliku.
+        }
+        file.close();
+    } else {
+        std::cerr << "Nie można otworzyć pliku do zapisu: wynikiSA.txt" << std::endl;
+    }
+}
+
+// Wczytuje ścieżkę z pliku i zwraca ją jako wektor (Checkpoint.h; komentarze z kosztem
+// zapisane przez writeTourFile są pomijane).
+std::vector<int> SimulatedAnnealing::loadPathFromFile(const std::string& filename) {
+    std::vector<int> path;
+    if (!readTourFile(filename, path)) {
+        std::cerr << "Nie można otworzyć pliku do odczytu: " << filename << std::endl;
+    }
+    return path;
+}
+
+// Stan potrzebny do kontynuacji: trasy, harmonogram, pula elitarna, licznik ruchów
+// i stan generatora liczb losowych. Koszty tras są liczone ponownie przy wczytaniu.
+void SimulatedAnnealing::saveState(const std::vector<int>& current, int bestCost, long long evaluations,
+                                   const AnnealingSchedule& annealing, const ElitePool& elite) {
+    Checkpoint state;
+    state.putCommon("sa", size, rng, best, bestCost, current, evaluations);
+    state.putReal("initial_temperature", temperatureBuffer);
+    const AnnealingSchedule::State schedule = annealing.state();
+    state.putReal("temperature", schedule.temperature);
+    state.putReal("improvement_temperature", schedule.improvementTemperature);
+    state.putInt("epoch_length", schedule.length);
+    state.putInt("frozen_epochs", schedule.frozenEpochs);
+    state.putInt("cycle_epochs", schedule.cycleEpochs);
+    state.putInt("stagnation_idle", schedule.stagnationIdle);
+    state.putInt("stagnation_limit", schedule.stagnationLimit);
+    state.putInt("elite_count", elite.size());
+    for (int i = 0; i < elite.size(); i++) {
+        state.putList("elite." + std::to_string(i), elite.path(i));
+    }
+    if (!state.save(checkpointPath)) {
+        std::cerr << "Nie można zapisać stanu przebiegu: " << checkpointPath << std::endl;
+    }
+}
+
+// Plik sprawdzany jest w resume(); tutaj brakujące wpisy zostawiają wartości startowe.
+void SimulatedAnnealing::restoreState(const Checkpoint& saved, std::vector<int>& current, int& bestCost,
+                                      long long& evaluations, AnnealingSchedule& annealing, ElitePool& elite) {
+    saved.getCommon(rng, best, current, evaluations);
+    bestCost = calculatePath(best);
+    AnnealingSchedule::State schedule = annealing.state();
+    long long value;
+    saved.getReal("temperature", schedule.temperature);
+    saved.getReal("improvement_temperature", schedule.improvementTemperature);
+    if (saved.getInt("epoch_length", value)) schedule.length = (int)value;
+    if (saved.getInt("frozen_epochs", value)) schedule.frozenEpochs = (int)value;
+    saved.getInt("cycle_epochs", schedule.cycleEpochs);
+    saved.getInt("stagnation_idle", schedule.stagnationIdle);
+    saved.getInt("stagnation_limit", schedule.stagnationLimit);
+    annealing.restore(schedule);
+    elite = ElitePool();
+    elite.offer(best, bestCost);
+    long long count = 0;
+    saved.getInt("elite_count", count);
+    std::vector<int> member;
+    for (int i = 0; i < count; i++) {
+        if (saved.getList("elite." + std::to_string(i), member) && isTour(member, size)) {
+            elite.offer(member, calculatePath(member));
+        }
+    }
+}
+
+// Wczytuje stan zapisany przez setCheckpoint() (Checkpoint::loadFor sprawdza jego zgodność).
+bool SimulatedAnnealing::resume(const std::string& path) {
+    std::unique_ptr<Checkpoint> saved(new Checkpoint());
+    if (!saved->loadFor(path, "sa", matrix)) {
+        return false;
+    }
+    saved->getReal("initial_temperature", temperatureBuffer);
+    resumed = std::move(saved);
+    return true;
+}
+
+void SimulatedAnnealing::setCheckpoint(const std::string& path, double interval) {
+    checkpointPath = path;
+    checkpointInterval = interval;
+}
+
+// Trasa musi być permutacją wszystkich wierzchołków instancji.
+bool SimulatedAnnealing::setInitialTour(const std::vector<int>& tour) {
+    if (!isTour(tour, size)) {
+        return false;
+    }
+    initialTour = tour;
+    return true;
+}
+// Szlifowanie najlepszej trasy (LocalSearch::polish); poprawa trafia do statystyk
+// i wspólnego najlepszego wyniku.
+bool SimulatedAnnealing::polishBest(std::vector<int>& best, int& cost, double& foundTime, Deadline& deadline, bool limited,
+                                    const SearchContext& context) {
+    if (!polish->polish(best, cost, limited ? &deadline : nullptr)) {
+        return false;
+    }
+    foundTime = deadline.elapsed();
+    stats.improved(foundTime, cost);
+    if (context.globalBest != nullptr) {
+        context.globalBest->offer(best, cost, foundTime);
+    }
+    return true;
+}
+
+void SimulatedAnnealing::setPolish(std::shared_ptr<const CandidateLists> lists, double interval) {
+    polish.reset(new LocalSearch(matrix, lists));
+    polishInterval = interval;
+}
+
+void SimulatedAnnealing::setSchedule(const ScheduleOptions& options) {
+    schedule = options;
+}
+
+void SimulatedAnnealing::setNeighborhood(const Neighborhood& moves) {
+    neighborhood = moves.rebind(matrix);
+}
+
+SimulatedAnnealing::~SimulatedAnnealing()
+{
+}
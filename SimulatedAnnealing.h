@@ -1,28 +1,62 @@
-#ifndef SIMULATED_ANNEALING_H
-#define SIMULATED_ANNEALING_H
-
-#include "adjacency_matrix.h"
-#include <vector>
-
-class SimulatedAnnealing {
-public:
-    SimulatedAnnealing(Adjacency_Matrix& graf, int time, double rate);
-    ~SimulatedAnnealing();
-    void apply();
-    void savePathToFile();
-    int calculatePath(std::vector<int> path);
-    std::vector<int> loadPathFromFile(const std::string& filename);
-private:
-    std::vector<std::vector<int>> matrix;
-    int size;
-    int timeBound;
-    double coolingRate;
-    double temperatureBuffer;
-    int numVertices;
-    vector<int> best;
-    std::vector<int> greedyPath();
-    std::vector<int> random_permutation(int _size);
-    double calculateTemperature();
-};
-
-#endif // SIMULATED_ANNEALING_H
\ No newline at end of file
+#ifndef SIMULATED_ANNEALING_H
+#define SIMULATED_ANNEALING_H
+
+#include "adjacency_matrix.h"
+#include "AnnealingSchedule.h"
+#include "Checkpoint.h"
+#include "Deadline.h"
+#include "LocalSearch.h"
+#include "Neighborhood.h"
+#include "SearchContext.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+class SimulatedAnnealing {
+public:
+    SimulatedAnnealing(const Adjacency_Matrix& graf, double time, double rate, uint64_t seed = std::random_device()());
+    ~SimulatedAnnealing();
+    void apply();
+    Tour solve(const SearchContext& context = SearchContext()); // Przebieg bez wypisywania wyników.
+    void setNeighborhood(const Neighborhood& moves); // Domyślnie losowa zamiana dowolnych dwóch pozycji.
+    void setPolish(std::shared_ptr<const CandidateLists> lists, double interval); // Szlifowanie najlepszej trasy co interval sekund (0 - tylko końcowej).
+    void setSchedule(const ScheduleOptions& options); // Polityki epok, chłodzenia i restartów.
+    bool setInitialTour(const std::vector<int>& tour); // Start z podanej trasy zamiast zachłannej.
+    void setCheckpoint(const std::string& path, double interval); // Zapis stanu co interval s i na końcu.
+    bool resume(const std::string& path); // Następny solve() kontynuuje przebieg zapisany w path.
+    void savePathToFile();
+    int calculatePath(const std::vector<int>& path) const;
+    std::vector<int> loadPathFromFile(const std::string& filename);
+    const SolverStats& statistics() const { return stats; }
+private:
+    MatrixView matrix; // Widok na macierz grafu; graf musi żyć dłużej niż solver.
+    int size;
+    double timeBound;
+    double coolingRate;
+    double temperatureBuffer;
+    double finalTemperature = 0; // Temperatura w chwili zakończenia ostatniego przebiegu.
+    ScheduleOptions schedule; // Harmonogram temperatury (AnnealingSchedule.h).
+    int numVertices;
+    Neighborhood neighborhood; // Sąsiedztwo, z którego losowane są ruchy.
+    std::unique_ptr<LocalSearch> polish; // Opcjonalny spadek Or-opt/or-3opt na najlepszej trasie.
+    double polishInterval = 0; // Sekundy między szlifowaniami (0 - tylko trasa końcowa).
+    SolverStats stats; // Liczniki ostatniego przebiegu (wypełniane tylko przy PEA_TELEMETRY).
+    Random rng; // Własny strumień liczb losowych, dzięki czemu solvery mogą działać w osobnych wątkach.
+    std::vector<int> best;
+    std::vector<int> greedy; // Trasa zachłanna (liczona przy pierwszym użyciu).
+    std::vector<int> initialTour; // Trasa startowa podana z zewnątrz (pusta - zachłanna).
+    std::string checkpointPath; // Plik stanu przebiegu (pusty - bez zapisu).
+    double checkpointInterval = 0; // Sekundy między zapisami stanu (0 - tylko na końcu).
+    std::unique_ptr<Checkpoint> resumed; // Stan wczytany przez resume(), zużywany przez solve().
+    std::vector<int> greedyPath();
+    double calculateTemperature();
+    bool accept(int delta, double inverseTemperature);
+    void saveState(const std::vector<int>& current, int bestCost, long long evaluations,
+                   const AnnealingSchedule& annealing, const ElitePool& elite);
+    void restoreState(const Checkpoint& saved, std::vector<int>& current, int& bestCost, long long& evaluations,
+                      AnnealingSchedule& annealing, ElitePool& elite);
+    bool polishBest(std::vector<int>& best, int& cost, double& foundTime, Deadline& deadline, bool limited,
+                    const SearchContext& context);
+};
+
+#endif // SIMULATED_ANNEALING_H
@@ -0,0 +1,172 @@
+#include "SolverApi.h"
+#include "adjacency_matrix.h"
+#include "Checkpoint.h"
+#include "ExactSolver.h"
+#include "ParallelTempering.h"
+#include "SimulatedAnnealing.h"
+#include "TabuSearch.h"
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace {
+
+// Limit czasu przy samym limicie ruchów: praktycznie nieograniczony, ale wciąż
+// reprezentowalny w zegarze steady_clock (ok. 31 lat).
+const double UNLIMITED_TIME = 1e9;
+
+std::string validate(const SolveRequest& request) {
+    const MatrixView& matrix = request.matrix;
+    if (matrix.data == nullptr || matrix.n < 1 || matrix.stride < matrix.n) {
+        return "pusta macierz albo stride mniejszy od n";
+    }
+    if (request.timeLimit <= 0 && request.evaluationLimit <= 0) {
+        return "brak limitu czasu i limitu ocenionych ruchow";
+    }
+    if (!request.initialTour.empty() && !isTour(request.initialTour, matrix.n)) {
+        return "trasa startowa nie jest permutacja wierzcholkow";
+    }
+    return "";
+}
+
+}
+
+// Solver tworzony jest na czas jednego żądania; Adjacency_Matrix tylko udostępnia bufor
+// wywołującego, więc nic nie jest kopiowane.
+SolveResult solveTour(const SolveRequest& request) {
+    SolveResult result;
+    result.error = validate(request);
+    if (!result.error.empty()) {
+        return result;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const Adjacency_Matrix graph(request.matrix);
+    const double time = request.timeLimit > 0 ? request.timeLimit : UNLIMITED_TIME;
+    const int threads = std::max(1, request.threads);
+    const SolverKind kind = request.matrix.n <= 3 ? SolverKind::Exact : request.algorithm;
+    const Neighborhood neighborhood(request.matrix, request.neighborhood, request.candidates);
+    std::shared_ptr<const CandidateLists> lists;
+    if (request.polish) {
+        lists = neighborhood.candidateLists();
+        if (lists == nullptr) {
+            lists = std::make_shared<const CandidateLists>(request.matrix, 10);
+        }
+    }
+    SearchContext context;
+    context.stop = request.cancel;
+    context.evaluationLimit = request.evaluationLimit;
+
+    Tour tour;
+    switch (kind) {
+        case SolverKind::TabuSearch: {
+            TabuSearch solver(graph, time, request.seed);
+            solver.setTenure(request.tabuTenure);
+            solver.setScanThreads(threads);
+            solver.setNeighborhood(neighborhood);
+            if (lists != nullptr) {
+                solver.setPolish(lists, 0);
+            }
+            if (!request.initialTour.empty()) {
+                solver.setInitialTour(request.initialTour);
+            }
+            tour = solver.solve(context);
+            result.stats = solver.statistics();
+            break;
+        }
+        case SolverKind::SimulatedAnnealing: {
+            if (threads > 1) {
+                // Niezależne łańcuchy ze wspólnym najlepszym wynikiem (ParallelSolver.h).
+                ParallelOptions options;
+                options.kind = SolverKind::SimulatedAnnealing;
+                options.threads = threads;
+                options.searchTime = time;
+                options.evaluationLimit = request.evaluationLimit;
+                options.coolingRate = request.coolingRate;
+                options.schedule = request.schedule;
+                options.seed = request.seed;
+                options.neighborhood = neighborhood;
+                options.polish = request.polish;
+                options.interrupt = request.cancel;
+                options.initialTour = request.initialTour;
+                tour = solveParallel(graph, options);
+                break;
+            }
+            SimulatedAnnealing solver(graph, time, request.coolingRate, request.seed);
+            solver.setSchedule(request.schedule);
+            solver.setNeighborhood(neighborhood);
+            if (lists != nullptr) {
+                solver.setPolish(lists, 0);
+            }
+            if (!request.initialTour.empty()) {
+                solver.setInitialTour(request.initialTour);
+            }
+            tour = solver.solve(context);
+            result.stats = solver.statistics();
+            break;
+        }
+        case SolverKind::ParallelTempering: {
+            ParallelTempering solver(graph, time, request.replicas > 0 ? request.replicas : std::max(8, threads),
+                                     request.seed);
+            solver.setThreads(threads);
+            solver.setNeighborhood(neighborhood);
+            if (lists != nullptr) {
+                solver.setPolish(lists);
+            }
+            tour = solver.solve(context);
+            result.stats = solver.statistics();
+            break;
+        }
+        case SolverKind::Memetic: {
+            MemeticAlgorithm solver(graph, time, request.seed);
+            solver.setOptions(request.memetic);
+            solver.setThreads(threads);
+            solver.setNeighborhood(neighborhood);
+            tour = solver.solve(context);
+            result.stats = solver.statistics();
+            break;
+        }
+        case SolverKind::Exact: {
+            ExactSolver solver(graph, time);
+            solver.setThreads(threads);
+            tour = solver.solve(context);
+            result.stats = solver.statistics();
+            result.proven = solver.proven();
+            break;
+        }
+    }
+
+    result.tour = std::move(tour.path);
+    result.cost = tour.cost;
+    result.foundTime = tour.foundTime;
+    result.evaluations = tour.evaluations;
+    result.cancelled = request.cancel != nullptr && request.cancel->load(std::memory_order_relaxed);
+    result.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// Zadania mają różne rozmiary i budżety, więc wątki pobierają je pojedynczo ze wspólnego
+// licznika zamiast dostać z góry równe części.
+std::vector<SolveResult> solveTours(const std::vector<SolveRequest>& requests, int threads) {
+    std::vector<SolveResult> results(requests.size());
+    if (threads <= 0) {
+        threads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, std::max(1, (int)requests.size()));
+    std::atomic<size_t> next{0};
+    const std::function<void(int)> work = [&](int) {
+        for (size_t i = next++; i < requests.size(); i = next++) {
+            results[i] = solveTour(requests[i]);
+        }
+    };
+    if (threads > 1) {
+        WorkerPool pool(threads);
+        pool.run(pool.size(), work);
+    } else {
+        work(0);
+    }
+    return results;
+}
@@ -0,0 +1,62 @@
+#ifndef PEA2_SOLVER_API_H
+#define PEA2_SOLVER_API_H
+
+#include <atomic>
+#include <climits>
+#include <string>
+#include <vector>
+#include "AnnealingSchedule.h"
+#include "DistanceMatrix.h"
+#include "Memetic.h"
+#include "Neighborhood.h"
+#include "ParallelSolver.h"
+#include "Telemetry.h"
+
+// Interfejs do osadzania solverów w innych programach (biblioteka Pea2Core). Wywołania
+// nie korzystają ze stanu globalnego: każdy solver ma własny generator liczb losowych
+// z ziarna żądania, nic nie jest wypisywane ani zapisywane do plików, więc wiele
+// rozwiązań może trwać naraz w jednym procesie. Macierz jest tylko czytana i może być
+// współdzielona przez równoczesne żądania.
+
+// Jedno zadanie: macierz, budżet, ziarno i token przerwania.
+struct SolveRequest {
+    MatrixView matrix;              // Bez kopiowania - bufor musi żyć do końca rozwiązywania.
+    SolverKind algorithm = SolverKind::TabuSearch;
+    double timeLimit = 1.0;         // Sekundy czasu ściennego (<= 0 - tylko evaluationLimit).
+    long long evaluationLimit = 0;  // > 0 - także limit ocenionych ruchów (SA na wielu wątkach - każdego wątku).
+    uint64_t seed = 1;              // TS i SA na jednym wątku z samym evaluationLimit: to samo ziarno - ta sama trasa.
+    int threads = 1;                // TS: przegląd sąsiedztwa, SA: niezależne łańcuchy, PT/MA/Exact: pula solvera.
+    const std::atomic<bool>* cancel = nullptr; // Ustawiona z innego wątku kończy rozwiązywanie przed czasem.
+    NeighborhoodKind neighborhood = NeighborhoodKind::FullSwap;
+    int candidates = 10;            // Długość list kandydatów sąsiedztw innych niż FullSwap.
+    bool polish = false;            // Przeszukiwanie lokalne (Or-opt, or-3opt) trasy końcowej.
+    double coolingRate = 0.99;      // SA.
+    ScheduleOptions schedule;       // SA.
+    int tabuTenure = 0;             // TS (0 - liczba wierzchołków).
+    int replicas = 0;               // PT (0 - max(8, threads)).
+    MemeticOptions memetic;         // MA.
+    std::vector<int> initialTour;   // TS i SA: trasa startowa zamiast zachłannej (pusta - zachłanna).
+};
+
+struct SolveResult {
+    std::vector<int> tour;          // Pusta, jeśli żądanie było niepoprawne (error).
+    int cost = INT_MAX;
+    double foundTime = 0;           // Sekundy od startu do znalezienia trasy.
+    double elapsed = 0;             // Czas całego rozwiązywania.
+    long long evaluations = 0;
+    bool proven = false;            // Exact: optymalność trasy udowodniona.
+    bool cancelled = false;         // Przerwane tokenem cancel.
+    SolverStats stats;              // Liczniki solvera (przy PEA_TELEMETRY; dla SA na wielu wątkach puste).
+    std::string error;              // Opis błędu żądania (pusty - rozwiązano).
+};
+
+// Rozwiązuje jedno zadanie na wątku wywołującym (i wątkach solvera, jeśli threads > 1).
+// Instancje do 3 miast rozwiązywane są dokładnie niezależnie od algorithm.
+SolveResult solveTour(const SolveRequest& request);
+
+// Rozwiązuje wiele niezależnych zadań naraz (np. wiele małych instancji): zadania pobierane
+// są kolejno przez threads wątków (0 - liczba rdzeni), a każde rozwiązywane jest jak przez
+// solveTour - zwykle z threads = 1 w żądaniu. Wyniki w kolejności żądań.
+std::vector<SolveResult> solveTours(const std::vector<SolveRequest>& requests, int threads = 0);
+
+#endif // PEA2_SOLVER_API_H
@@ -0,0 +1,90 @@
+#include "TabuList.h"
+
+#include <algorithm>
+
+TabuList::TabuList(int tenure) {
+    setTenure(tenure);
+}
+
+void TabuList::setTenure(int tenure) {
+    length = std::max(1, tenure);
+    int bits = 1;
+    while ((1LL << bits) < 2LL * length) {
+        bits++;
+    }
+    slots.assign((size_t)1 << bits, Slot());
+    mask = (uint32_t)((1ull << bits) - 1);
+    shift = 64 - bits;
+    queue.assign(length, Entry{0, 0});
+    epoch = 1;
+    head = 0;
+    count = 0;
+}
+
+void TabuList::clear() {
+    head = 0;
+    count = 0;
+    if (++epoch == 0) {
+        // Po przepełnieniu licznika epok stare wpisy mogłyby znów wyglądać na aktualne.
+        std::fill(slots.begin(), slots.end(), Slot());
+        epoch = 1;
+    }
+}
+
+void TabuList::add(uint64_t key, long long iteration) {
+    // Zwolnienie miejsca po zakazach, które już wygasły (zawsze najstarsze w kolejce).
+    while (count > 0 && (queue[head].expiry <= iteration || count == length)) {
+        erase(queue[head].key, queue[head].expiry);
+        head = head + 1 == length ? 0 : head + 1;
+        count--;
+    }
+    const long long expiry = iteration + length + 1;
+    uint32_t i = home(key);
+    while (slots[i].epoch == epoch && slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    slots[i].key = key;
+    slots[i].expiry = expiry; // Ponowny zakaz tego samego ruchu przedłuża istniejący wpis.
+    slots[i].epoch = epoch;
+    int tail = head + count;
+    queue[tail >= length ? tail - length : tail] = Entry{key, expiry};
+    count++;
+}
+
+std::vector<TabuList::Entry> TabuList::entries() const {
+    std::vector<Entry> active;
+    active.reserve(count);
+    for (int i = 0; i < count; i++) {
+        active.push_back(queue[head + i >= length ? head + i - length : head + i]);
+    }
+    return active;
+}
+
+void TabuList::restore(const std::vector<Entry>& entries) {
+    clear();
+    for (const Entry& entry : entries) {
+        add(entry.key, entry.expiry - length - 1);
+    }
+}
+
+// Usuwa wpis, chyba że w międzyczasie został przedłużony. Dalsze wpisy łańcucha są
+// przesuwane wstecz (bez znaczników usunięcia), więc wyszukiwanie kończy się na pierwszym
+// wolnym miejscu.
+void TabuList::erase(uint64_t key, long long expiry) {
+    uint32_t i = home(key);
+    while (slots[i].epoch == epoch && slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    if (slots[i].epoch != epoch || slots[i].expiry != expiry) {
+        return;
+    }
+    for (uint32_t j = (i + 1) & mask; slots[j].epoch == epoch; j = (j + 1) & mask) {
+        // Wpis z j może wypełnić lukę w i, jeśli jego miejsce domowe nie leży w (i, j].
+        const uint32_t target = home(slots[j].key);
+        if (((j - target) & mask) >= ((j - i) & mask)) {
+            slots[i] = slots[j];
+            i = j;
+        }
+    }
+    slots[i].epoch = 0;
+}
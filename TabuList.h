@@ -0,0 +1,72 @@
+#ifndef PEA2_TABU_LIST_H
+#define PEA2_TABU_LIST_H
+
+#include <cstdint>
+#include <vector>
+
+// Pamięć tabu przechowująca tylko ruchy, które są jeszcze zakazane. Atrybut ruchu (np. para
+// pozycji lub wierzchołków zakodowana w 64 bitach) trafia do tablicy haszującej z adresowaniem
+// otwartym razem z bezwzględnym numerem iteracji, w której zakaz wygasa. Zakazy wygasają
+// w kolejności dodania, więc kolejka cykliczna wskazuje, który wpis usunąć. Pamięć rośnie
+// z kadencją, a nie z n^2, a clear() przy restarcie tylko zmienia epokę - O(1).
+class TabuList {
+public:
+    // Zakaz ruchu o atrybucie key, ważny do iteracji expiry (wyłącznie).
+    struct Entry {
+        uint64_t key;
+        long long expiry;
+    };
+
+    explicit TabuList(int tenure = 1);
+
+    // Długość zakazu w iteracjach; zmiana czyści listę.
+    void setTenure(int tenure);
+    int tenure() const { return length; }
+
+    // Czy ruch o atrybucie key jest zakazany w iteracji iteration.
+    bool isTabu(uint64_t key, long long iteration) const {
+        for (uint32_t i = home(key);; i = (i + 1) & mask) {
+            const Slot& slot = slots[i];
+            if (slot.epoch != epoch) {
+                return false;
+            }
+            if (slot.key == key) {
+                return slot.expiry > iteration;
+            }
+        }
+    }
+
+    // Zakazuje ruchu o atrybucie key w iteracjach [iteration + 1, iteration + tenure].
+    void add(uint64_t key, long long iteration);
+
+    // Usuwa wszystkie zakazy w O(1).
+    void clear();
+
+    // Zakazy w kolejności dodania (do zapisu stanu przebiegu) i ich odtworzenie przy tej
+    // samej kadencji - add() wpisów w tej kolejności daje tę samą tablicę i kolejkę.
+    std::vector<Entry> entries() const;
+    void restore(const std::vector<Entry>& entries);
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        long long expiry = 0;
+        uint32_t epoch = 0; // Wpis jest zajęty tylko w bieżącej epoce.
+    };
+
+    int length = 1;
+    uint32_t epoch = 1;
+    uint32_t mask = 0;
+    int shift = 0;
+    std::vector<Slot> slots;     // Rozmiar - potęga dwójki, co najmniej 2 * tenure.
+    std::vector<Entry> queue;    // Zakazy w kolejności wygasania (kolejka cykliczna).
+    int head = 0;
+    int count = 0;
+
+    uint32_t home(uint64_t key) const {
+        return (uint32_t)((key * 0x9e3779b97f4a7c15ull) >> shift); // Haszowanie Fibonacciego.
+    }
+    void erase(uint64_t key, long long expiry);
+};
+
+#endif // PEA2_TABU_LIST_H
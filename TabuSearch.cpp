@@ -1,156 +1,460 @@
-#include "TabuSearch.h"
-#include <time.h>
-#include <iostream>
-#include <algorithm>
-#include <ctime>
-#include <random>
-
-// Konstruktor klasy TabuSearch.
-TabuSearch::TabuSearch(Adjacency_Matrix graph, int time) {
-    matrix = graph.getMatrix(); // Pobranie macierzy sąsiedztwa z grafu.
-    size = graph.getNumVertices(); // Ustalenie liczby wierzchołków.
-    searchTime = time; // Ustawienie maksymalnego czasu działania.
-}
-
-// Główna metoda algorytmu apply.
-void TabuSearch::apply() {
-    vector<vector<int>> tabuMatrix; // Tablica tabu do śledzenia niedozwolonych ruchów.
-    vector<int> best = greedyPath(); // Ustalenie początkowej ścieżki metodą zachłanną.
-    vector<int> permutation = randomPermutation(size); // Losowa permutacja wierzchołków.
-    vector<int> next(permutation); // Kolejna permutacja do rozważenia.
-    int result = calculatePath(best); // Koszt najlepszej ścieżki.
-    int firstToSwap, secondToSwap; // Indeksy wierzchołków do zamiany.
-    int nextCost; // Koszt kolejnej permutacji.
-    std::clock_t start; // Początek pomiaru czasu.
-    double time; // Czas działania algorytmu.
-    double foundTime; // Czas znalezienia najlepszego rozwiązania.
-    tabuMatrix.resize(size); // Inicjalizacja tablicy tabu.
-    for (int j = 0; j < size; j++) {
-        tabuMatrix[j].resize(size, 0); // Ustawienie początkowych wartości tablicy tabu.
-    }
-    const double iterationTimeLimit = 30.0; // Limit czasu na iterację w sekundach.
-    start = std::clock();
-
-    // Główna pętla algorytmu.
-    while (true) {
-        double iterationStart = std::clock(); // Początek iteracji.
-        for (int step = 0; step < 15 * size; step++) {
-            firstToSwap = 0;
-            secondToSwap = 0;
-            nextCost = INT_MAX;
-            // Przeszukiwanie wszystkich par wierzchołków do zamiany.
-            for (int first = 0; first < size; first++) {
-                for (int second = first + 1; second < size; second++) {
-                    std::swap(permutation[first], permutation[second]); // Zamiana wierzchołków.
-                    int currentCost = calculatePath(permutation); // Obliczenie kosztu permutacji.
-
-                    // Aktualizacja najlepszego wyniku i permutacji.
-                    if (currentCost < result) {
-                        result = currentCost;
-                        best = permutation;
-                        foundTime = (std::clock() - start) / (double)CLOCKS_PER_SEC;
-                    }
-
-                    // Sprawdzenie, czy aktualna permutacja jest lepsza od następnej.
-                    // Sprawdzenie, czy ruch jest dozwolony (nie znajduje się na liście tabu).
-                    if (currentCost < nextCost && tabuMatrix[first][second] < step) {
-                        nextCost = currentCost;
-                        next = permutation;
-                        firstToSwap = first;
-                        secondToSwap = second;
-                    }
-                    std::swap(permutation[first], permutation[second]); // Przywrócenie poprzedniego stanu.
-                    time = (std::clock() - start) / (double)CLOCKS_PER_SEC;
-
-                    // Sprawdzenie warunku zakończenia.
-                    if (time >= searchTime) {
-                        std::ofstream file("wynikiTS.txt");
-                        cout << "Droga: ";
-                        for (int d = 0; d < size; d++) {
-                            cout << best[d] << " ";
-                            file << best[d] << " "; // Zapis do pliku.
-                        }
-                        cout << "\nKoszt: " << result << endl;
-                        cout << "Znaleziono po: " << foundTime << " s " << endl;
-                        return; // Zakończenie algorytmu.
-                    }
-                }
-            }
-
-            // Aktualizacja tablicy tabu.
-            // Zwiększenie wartości tabu dla ostatnio wykonanego ruchu.
-            // Zapobiega to powtórzeniu tego samego ruchu w najbliższej przyszłości.
-            permutation = next;
-            tabuMatrix[firstToSwap][secondToSwap] += size;
-
-            // Sprawdzenie, czy czas iteracji nie przekroczył limitu.
-            double currentTime = (std::clock() - iterationStart) / (double)CLOCKS_PER_SEC;
-            if (currentTime >= iterationTimeLimit) {
-                break; // Przerwanie obecnej iteracji, jeśli limit czasu został przekroczony.
-            }
-        }
-
-        // Resetowanie tablicy tabu i generowanie nowej losowej permutacji.
-        permutation = randomPermutation(size);
-        for (auto &row : tabuMatrix) {
-            std::fill(row.begin(), row.end(), 0); // Resetowanie tablicy tabu.
-        }
-    }
-}
-
-// Generuje losową permutację wierzchołków grafu.
-vector<int> TabuSearch::randomPermutation(int _size) {
-    std::vector<int> temp;
-    temp.reserve(_size);
-    for (int i = 0; i < _size; i++) {
-        temp.push_back(i); // Dodanie każdego wierzchołka do permutacji.
-    }
-    std::random_device rd; // Inicjalizacja generatora liczb losowych.
-    std::mt19937 g(rd());  // Generator liczb losowych.
-    std::shuffle(temp.begin(), temp.end(), g); // Mieszanie permutacji.
-    return temp;
-}
-
-// Oblicza koszt danej ścieżki w grafie.
-int TabuSearch::calculatePath(std::vector<int> path) {
-    int cost = 0;
-    for (int i = 0; i < path.size() - 1; i++) {
-        cost += matrix[path[i]][path[i + 1]]; // Dodawanie kosztu krawędzi.
-    }
-    cost += matrix[path[path.size() - 1]][path[0]]; // Dodanie kosztu powrotu do punktu startowego.
-    return cost;
-}
-
-// Generuje początkową ścieżkę metodą zachłanną.
-std::vector<int> TabuSearch::greedyPath() {
-    std::vector<int> path;
-    std::vector<bool> visited(size, false);
-    int current = 0; // Start z pierwszego wierzchołka.
-    path.push_back(current);
-    visited[current] = true;
-    int totalCost = 0;
-    for (int i = 1; i < size; i++) {
-        int nearest = -1;
-        int minDistance = INT_MAX;
-        // Szukanie najbliższego nieodwiedzonego wierzchołka.
-        for (int j = 0; j < size; j++) {
-            if (!visited[j] && matrix[current][j] < minDistance) {
-                nearest = j;
-                minDistance = matrix[current][j];
-            }
-        }
-        // Dodanie wierzchołka do ścieżki.
-        if (nearest != -1) {
-            path.push_back(nearest);
-            visited[nearest] = true;
-            totalCost += minDistance;
-            current = nearest;
-        }
-    }
-    totalCost += matrix[current][path[0]]; // Dodanie kosztu powrotu do startu.
-    return path;
-}
-
-TabuSearch::~TabuSearch()
-{
-}
+#include "TabuSearch.h"
+#include "AllocationCounter.h"
+#include "AnnealingSchedule.h"
+#include "Greedy.h"
+#include "Moves.h"
+#include <time.h>
+#include <iostream>
+#include <algorithm>
+#include <ctime>
+#include <functional>
+#include <random>
+#include <climits>
+
+using namespace std;
+
+// Konstruktor klasy TabuSearch.
+TabuSearch::TabuSearch(const Adjacency_Matrix& graph, double time, uint64_t seed) : rng(seed) {
+    matrix = graph.getView(); // Widok na macierz sąsiedztwa grafu (bez kopiowania).
+    size = graph.getNumVertices(); // Ustalenie liczby wierzchołków.
+    searchTime = time; // Ustawienie maksymalnego czasu działania.
+    neighborhood = Neighborhood(matrix, NeighborhoodKind::FullSwap); // Domyślnie pełny przegląd zamian.
+}
+
+// Uruchamia przeszukiwanie i wypisuje wynik.
+void TabuSearch::apply() {
+    Tour result = solve();
+    std::ofstream file("wynikiTS.txt");
+    cout << "Droga: ";
+    for (int d = 0; d < size; d++) {
+        cout << result.path[d] << " ";
+        file << result.path[d] << " "; // Zapis do pliku.
+    }
+    cout << "\nKoszt: " << result.cost << endl;
+    cout << "Znaleziono po: " << result.foundTime << " s " << endl;
+}
+
+// Główna metoda algorytmu. Czas liczony jest zegarem ściennym (Deadline), aby przy wielu
+// wątkach limit searchTime oznaczał rzeczywisty czas działania.
+Tour TabuSearch::solve(const SearchContext& context) {
+    // Ustalenie początkowej ścieżki metodą zachłanną (albo podanej z zewnątrz).
+    vector<int> best = initialTour.empty() ? greedyPath() : initialTour;
+    // Losowa permutacja wierzchołków (przy podanej trasie - ta trasa).
+    vector<int> permutation = initialTour.empty() ? randomPermutation(size) : initialTour;
+    vector<int> position; // Pozycje wierzchołków w permutacji (dla sąsiedztw z listami kandydatów).
+    Move nextMove; // Ruch wykonywany w kroku.
+    int nextCost; // Koszt kolejnej permutacji.
+    double foundTime = 0; // Czas znalezienia najlepszego rozwiązania (od wznowienia).
+    long long evaluations = 0; // Liczba ocenionych ruchów.
+    long long resumedEvaluations = 0; // Ruchy ocenione przed wznowieniem (tylko do zapisu stanu).
+    long long iteration = 0; // Numer kroku liczony przez cały przebieg (także przez restarty).
+    long long resumedIdle = 0; // Kroki bez poprawy przed zapisem stanu (tylko pierwsza iteracja po wznowieniu).
+    tabu.setTenure(tenure > 0 ? tenure : size); // Pusta lista tabu.
+    int result = calculatePath(best); // Koszt najlepszej ścieżki.
+    int restartBest = calculatePath(permutation); // Najlepszy bieżący koszt od ostatniego restartu.
+    if (resumed != nullptr) {
+        // Stan sprawdzony w resume(); brakujące wpisy zostawiają wartości startowe.
+        std::vector<uint64_t> keys, expiries;
+        resumed->getCommon(rng, best, permutation, resumedEvaluations);
+        result = calculatePath(best);
+        resumed->getInt("iteration", iteration);
+        resumed->getInt("stagnation_idle", resumedIdle);
+        long long value = calculatePath(permutation), savedTenure = 0;
+        resumed->getInt("restart_best", value);
+        restartBest = (int)value;
+        // Zakazy odtwarzane tylko przy tej samej kadencji - inna zmienia znaczenie wygasania.
+        if (resumed->getInt("tenure", savedTenure) && savedTenure == tabu.tenure()
+            && resumed->getWords("tabu_keys", keys) && resumed->getWords("tabu_expiry", expiries)
+            && keys.size() == expiries.size()) {
+            std::vector<TabuList::Entry> entries(keys.size());
+            for (size_t i = 0; i < keys.size(); i++) {
+                entries[i] = TabuList::Entry{keys[i], (long long)expiries[i]};
+            }
+            tabu.restore(entries);
+        }
+        resumed.reset();
+    }
+    Neighborhood::indexPositions(permutation, position);
+    int currentCost = calculatePath(permutation); // Bieżący koszt permutacji, aktualizowany o delty ruchów.
+    PeriodicTimer checkpointTimer(checkpointInterval); // Okresowy zapis stanu.
+    const double iterationTimeLimit = 30.0; // Limit czasu na iterację w sekundach.
+    Deadline deadline(searchTime, context.stop);
+    PeriodicTimer migrationTimer(context.migrationInterval); // Wymiana z sąsiednią wyspą.
+    PeriodicTimer polishTimer(polishInterval); // Szlifowanie najlepszej trasy.
+    PeriodicTimer snapshotTimer(context.telemetry != nullptr ? context.telemetry->interval() : 0); // Migawki.
+    stats = SolverStats();
+    stats.improved(0, result);
+    if (context.globalBest != nullptr) {
+        context.globalBest->offer(best, result, 0);
+    }
+    // Granice bloków wierszy o zbliżonej liczbie par (wiersz first ma size - first - 1 par).
+    std::vector<int> rowBounds{0};
+    if (pool != nullptr) {
+        const int blocks = 4 * pool->size();
+        const long long pairs = (long long)size * (size - 1) / 2;
+        long long counted = 0;
+        for (int first = 0; first < size; first++) {
+            counted += size - first - 1;
+            if (counted * blocks >= pairs * (long long)rowBounds.size() && (int)rowBounds.size() < blocks) {
+                rowBounds.push_back(first + 1);
+            }
+        }
+        if (rowBounds.back() != size) {
+            rowBounds.push_back(size);
+        }
+    }
+    // Wyniki bloków i zadanie puli tworzone raz: std::function z tyloma przechwyceniami
+    // alokowałby pamięć przy każdym kroku.
+    std::vector<MoveScan> parts(rowBounds.size() - 1);
+    const std::function<void(int)> scanBlock = [&](int task) {
+        parts[task] = MoveScan();
+        scanRows(rowBounds[task], rowBounds[task + 1], permutation, currentCost, iteration, result, deadline, parts[task]);
+    };
+    const long long allocationBase = allocationCount(); // Alokacje sprzed pętli głównej nie są liczone.
+
+    // Główna pętla algorytmu.
+    while (true) {
+        const double iterationStart = deadline.lastElapsed(); // Początek iteracji.
+        // Restart po 2 * tenure krokach bez poprawy najlepszego kosztu od ostatniego restartu.
+        StagnationDetector stagnation(2LL * tabu.tenure());
+        stagnation.restore(resumedIdle);
+        resumedIdle = 0;
+        for (;; iteration++) {
+            // Przeszukiwanie wszystkich par wierzchołków do zamiany, na dużych instancjach
+            // równolegle w blokach wierszy; wynik jest taki sam jak przy przeglądzie sekwencyjnym.
+            MoveScan scan;
+            if (neighborhood.kind() != NeighborhoodKind::FullSwap) {
+                scanNeighborhood(permutation, position, currentCost, iteration, result, scan);
+            } else if (pool != nullptr) {
+                pool->run((int)parts.size(), scanBlock);
+                for (const MoveScan& part : parts) {
+                    scan.merge(part);
+                }
+            } else {
+                scanRows(0, size, permutation, currentCost, iteration, result, deadline, scan);
+            }
+            nextMove = scan.nextMove;
+            nextCost = scan.nextCost;
+            evaluations += scan.evaluated;
+            if (TELEMETRY_ENABLED) {
+                stats.iterations++;
+                stats.tabuBlocked += scan.tabuBlocked;
+            }
+
+            // Aktualizacja najlepszego wyniku i permutacji.
+            if (scan.bestCost < result) {
+                result = scan.bestCost;
+                best = permutation;
+                Neighborhood::apply(scan.bestMove, best);
+                foundTime = deadline.elapsed();
+                stats.improved(foundTime, result);
+                if (context.globalBest != nullptr) {
+                    context.globalBest->offer(best, result, foundTime);
+                }
+            }
+
+            // Sprawdzenie warunku zakończenia.
+            if (scan.expired || deadline.expired() || context.budgetSpent(evaluations)) {
+                if (polish != nullptr) {
+                    polishBest(best, result, foundTime, deadline, false, context);
+                }
+                if (!checkpointPath.empty()) {
+                    // Ruch tego kroku nie został wykonany - wznowiony przebieg powtórzy krok.
+                    saveState(best, result, permutation, iteration, resumedEvaluations + evaluations, stagnation.idleSteps(),
+                              restartBest);
+                }
+                if (TELEMETRY_ENABLED && context.telemetry != nullptr) {
+                    stats.evaluations = evaluations;
+                    stats.allocations = allocationCount() - allocationBase;
+                    context.telemetry->finish("ts", context.island, deadline.elapsed(), stats, result);
+                }
+                return Tour{best, result, foundTime, evaluations}; // Zakończenie algorytmu.
+            }
+
+            // Aktualizacja listy tabu: wykonany ruch jest zakazany przez kolejne tenure iteracji.
+            // Zapobiega to powtórzeniu tego samego ruchu w najbliższej przyszłości.
+            if (nextCost != INT_MAX) {
+                tabu.add(tabuKey(nextMove, permutation), iteration);
+                Neighborhood::apply(nextMove, permutation, position);
+                currentCost = nextCost;
+                if (TELEMETRY_ENABLED) stats.accepted++;
+            } else if (TELEMETRY_ENABLED) {
+                stats.rejected++; // Wszystkie ruchy kroku były na liście tabu.
+            }
+            const bool progressed = currentCost < restartBest;
+            restartBest = std::min(restartBest, currentCost);
+            if (stagnation.update(progressed)) {
+                break;
+            }
+
+            // Model wyspowy: oddanie najlepszej trasy sąsiadowi i przejęcie lepszego imigranta.
+            Tour incoming;
+            if (context.receiveImmigrant(migrationTimer, deadline.lastElapsed(), best, result, foundTime, currentCost,
+                                         incoming)) {
+                permutation = incoming.path;
+                Neighborhood::indexPositions(permutation, position);
+                currentCost = incoming.cost;
+                if (currentCost < result) {
+                    best = permutation;
+                    result = currentCost;
+                    stats.improved(deadline.lastElapsed(), result);
+                }
+                tabu.clear();
+            }
+
+            // Okresowe szlifowanie najlepszej trasy; bieżąca permutacja pozostaje bez zmian.
+            if (polish != nullptr && polishTimer.due(deadline.lastElapsed())) {
+                polishBest(best, result, foundTime, deadline, true, context);
+            }
+
+            // Okresowa migawka statystyk przebiegu.
+            if (TELEMETRY_ENABLED && context.telemetry != nullptr && snapshotTimer.due(deadline.lastElapsed())) {
+                stats.evaluations = evaluations;
+                stats.allocations = allocationCount() - allocationBase;
+                context.telemetry->snapshot("ts", context.island, deadline.lastElapsed(), stats, currentCost, result);
+            }
+
+            // Okresowy zapis stanu przebiegu; kolejny krok ma numer iteration + 1.
+            if (!checkpointPath.empty() && checkpointTimer.due(deadline.lastElapsed())) {
+                saveState(best, result, permutation, iteration + 1, resumedEvaluations + evaluations, stagnation.idleSteps(),
+                          restartBest);
+            }
+
+            // Sprawdzenie, czy czas iteracji nie przekroczył limitu.
+            double currentTime = deadline.lastElapsed() - iterationStart;
+            if (currentTime >= iterationTimeLimit) {
+                break; // Przerwanie obecnej iteracji, jeśli limit czasu został przekroczony.
+            }
+        }
+
+        // Resetowanie listy tabu i dywersyfikacja: restart z najlepszej trasy zaburzonej
+        // przestawieniami double bridge zamiast z nowej losowej permutacji.
+        permutation = best;
+        doubleBridgeKick(permutation, 1 + size / 100, rng);
+        Neighborhood::indexPositions(permutation, position);
+        currentCost = calculatePath(permutation);
+        restartBest = currentCost;
+        tabu.clear(); // Resetowanie listy tabu (O(1)).
+        if (TELEMETRY_ENABLED) stats.restarts++;
+    }
+}
+
+// Przegląda zamiany (first, second) dla wierszy first z zakresu [from, to). Ruchy są
+// porównywane kosztem, a przy remisie kolejnością (first, second), więc scalenie bloków
+// daje ten sam ruch, który wybrałby przegląd sekwencyjny. Lista tabu sprawdzana jest tylko
+// dla ruchów lepszych od dotychczas wybranego, więc nie obciąża pętli po parach.
+void TabuSearch::scanRows(int from, int to, const std::vector<int>& permutation, int currentCost, long long iteration,
+                          int aspiration, const Deadline& deadline, MoveScan& scan) {
+    const int rowsPerCheck = std::max(1, 4096 / size); // Zegar odczytywany co ok. 4096 par.
+    for (int first = from; first < to; first++) {
+        const uint64_t rowKey = (uint64_t)first * size;
+        scan.evaluated += size - first - 1;
+        for (int second = first + 1; second < size; second++) {
+            // Koszt sąsiada liczony z samych krawędzi zmienionych przez zamianę.
+            int candidateCost = currentCost + swapDelta(matrix, permutation, first, second);
+            if (candidateCost < scan.bestCost) {
+                scan.bestCost = candidateCost;
+                scan.bestMove = Move{first, second, -1, candidateCost - currentCost};
+            }
+            // Ruch dozwolony, jeśli nie znajduje się na liście tabu albo daje nowy najlepszy
+            // wynik (kryterium aspiracji).
+            if (candidateCost < scan.nextCost) {
+                if (candidateCost < aspiration || !tabu.isTabu(rowKey + second, iteration)) {
+                    scan.nextCost = candidateCost;
+                    scan.nextMove = Move{first, second, -1, candidateCost - currentCost};
+                } else if (TELEMETRY_ENABLED) {
+                    scan.tabuBlocked++;
+                }
+            }
+        }
+        // Sprawdzenie warunku zakończenia.
+        if ((first + 1) % rowsPerCheck == 0 && deadline.reached()) {
+            scan.expired = true;
+            return;
+        }
+    }
+}
+
+// Przegląda ruchy sąsiedztwa z list kandydatów (O(n*k) zamiast O(n^2) par).
+void TabuSearch::scanNeighborhood(const std::vector<int>& permutation, const std::vector<int>& position, int currentCost,
+                                  long long iteration, int aspiration, MoveScan& scan) {
+    neighborhood.forEachMove(permutation, position, [&](const Move& move) {
+        scan.evaluated++;
+        int candidateCost = currentCost + move.delta;
+        if (candidateCost < scan.bestCost) {
+            scan.bestCost = candidateCost;
+            scan.bestMove = move;
+        }
+        if (candidateCost < scan.nextCost) {
+            if (candidateCost < aspiration || !isTabu(move, permutation, iteration)) {
+                scan.nextCost = candidateCost;
+                scan.nextMove = move;
+            } else if (TELEMETRY_ENABLED) {
+                scan.tabuBlocked++;
+            }
+        }
+    });
+}
+
+// Atrybut wykonanego ruchu na liście tabu (para zakodowana jako x * n + y). Pełny przegląd
+// zamian zapamiętuje pary pozycji, zamiana z list kandydatów - nieuporządkowaną parę
+// wierzchołków. Wymiana segmentów A B C -> A C B zakazuje usuniętej krawędzi koniec A ->
+// początek B (klucze krawędzi przesunięte o n * n), więc cofnięcie ruchu, a także każdy inny
+// ruch przywracający tę krawędź, czeka tenure iteracji.
+uint64_t TabuSearch::tabuKey(const Move& move, const std::vector<int>& permutation) const {
+    if (neighborhood.kind() == NeighborhoodKind::FullSwap) {
+        return (uint64_t)move.a * size + move.b;
+    }
+    if (move.c < 0) {
+        const int x = std::min(permutation[move.a], permutation[move.b]);
+        const int y = std::max(permutation[move.a], permutation[move.b]);
+        return (uint64_t)x * size + y;
+    }
+    return edgeKey(permutation[move.a], permutation[move.a + 1]);
+}
+
+uint64_t TabuSearch::edgeKey(int from, int to) const {
+    return (uint64_t)size * size + (uint64_t)from * size + to;
+}
+
+// Zamiany sprawdzane są po swoim atrybucie, wymiana segmentów - po trzech dodawanych krawędziach
+// (te same, co w exchangeDelta).
+bool TabuSearch::isTabu(const Move& move, const std::vector<int>& permutation, long long iteration) const {
+    if (move.c < 0) {
+        return tabu.isTabu(tabuKey(move, permutation), iteration);
+    }
+    const int p = permutation[move.a], pNext = permutation[move.a + 1];
+    const int q = permutation[move.b], qNext = permutation[move.b + 1];
+    const int r = permutation[move.c], rNext = permutation[(move.c + 1) % size];
+    return tabu.isTabu(edgeKey(p, qNext), iteration) || tabu.isTabu(edgeKey(r, pNext), iteration)
+           || tabu.isTabu(edgeKey(q, rNext), iteration);
+}
+
+// Ruchy porównywane są kosztem, a przy remisie pozycjami (a, b), czyli kolejnością przeglądu.
+void TabuSearch::MoveScan::merge(const MoveScan& other) {
+    if (other.bestCost < bestCost
+        || (other.bestCost == bestCost && (other.bestMove.a < bestMove.a || (other.bestMove.a == bestMove.a && other.bestMove.b < bestMove.b)))) {
+        bestCost = other.bestCost;
+        bestMove = other.bestMove;
+    }
+    if (other.nextCost < nextCost
+        || (other.nextCost == nextCost && (other.nextMove.a < nextMove.a || (other.nextMove.a == nextMove.a && other.nextMove.b < nextMove.b)))) {
+        nextCost = other.nextCost;
+        nextMove = other.nextMove;
+    }
+    evaluated += other.evaluated;
+    tabuBlocked += other.tabuBlocked;
+    expired = expired || other.expired;
+}
+
+// Szlifowanie najlepszej trasy (LocalSearch::polish) z zapisem poprawy w statystykach
+// i we wspólnym najlepszym wyniku; limited - w limicie czasu przebiegu.
+bool TabuSearch::polishBest(std::vector<int>& best, int& cost, double& foundTime, Deadline& deadline, bool limited,
+                            const SearchContext& context) {
+    if (!polish->polish(best, cost, limited ? &deadline : nullptr)) {
+        return false;
+    }
+    foundTime = deadline.elapsed();
+    stats.improved(foundTime, cost);
+    if (context.globalBest != nullptr) {
+        context.globalBest->offer(best, cost, foundTime);
+    }
+    return true;
+}
+
+// Stan potrzebny do kontynuacji: trasy, numer kroku, lista tabu, licznik stagnacji
+// i stan generatora liczb losowych. Koszty tras są liczone ponownie przy wczytaniu.
+void TabuSearch::saveState(const std::vector<int>& best, int bestCost, const std::vector<int>& permutation,
+                           long long iteration, long long evaluations, long long idle, int restartBest) {
+    Checkpoint state;
+    state.putCommon("ts", size, rng, best, bestCost, permutation, evaluations);
+    state.putInt("iteration", iteration);
+    state.putInt("stagnation_idle", idle);
+    state.putInt("restart_best", restartBest);
+    state.putInt("tenure", tabu.tenure());
+    std::vector<uint64_t> keys, expiries;
+    for (const TabuList::Entry& entry : tabu.entries()) {
+        keys.push_back(entry.key);
+        expiries.push_back((uint64_t)entry.expiry);
+    }
+    state.putWords("tabu_keys", keys);
+    state.putWords("tabu_expiry", expiries);
+    if (!state.save(checkpointPath)) {
+        std::cerr << "Nie można zapisać stanu przebiegu: " << checkpointPath << std::endl;
+    }
+}
+
+// Wczytuje stan zapisany przez setCheckpoint() (Checkpoint::loadFor sprawdza jego zgodność).
+bool TabuSearch::resume(const std::string& path) {
+    std::unique_ptr<Checkpoint> saved(new Checkpoint());
+    if (!saved->loadFor(path, "ts", matrix)) {
+        return false;
+    }
+    resumed = std::move(saved);
+    return true;
+}
+
+void TabuSearch::setCheckpoint(const std::string& path, double interval) {
+    checkpointPath = path;
+    checkpointInterval = interval;
+}
+
+// Trasa musi być permutacją wszystkich wierzchołków instancji.
+bool TabuSearch::setInitialTour(const std::vector<int>& tour) {
+    if (!isTour(tour, size)) {
+        return false;
+    }
+    initialTour = tour;
+    return true;
+}
+
+// Długość zakazu w krokach; 0 - liczba wierzchołków.
+void TabuSearch::setTenure(int iterations) {
+    tenure = std::max(0, iterations);
+}
+
+void TabuSearch::setPolish(std::shared_ptr<const CandidateLists> lists, double interval) {
+    polish.reset(new LocalSearch(matrix, lists));
+    polishInterval = interval;
+}
+
+void TabuSearch::setNeighborhood(const Neighborhood& moves) {
+    neighborhood = moves.rebind(matrix);
+}
+
+// Równoległy przegląd opłaca się dopiero, gdy krok (size^2 / 2 par) jest dużo droższy
+// od wybudzenia puli wątków.
+void TabuSearch::setScanThreads(int threads) {
+    const int minimumParallelSize = 150;
+    if (threads > 1 && size >= minimumParallelSize) {
+        pool.reset(new WorkerPool(threads));
+    } else {
+        pool.reset();
+    }
+}
+
+// Generuje losową permutację wierzchołków grafu.
+vector<int> TabuSearch::randomPermutation(int _size) {
+    std::vector<int> temp;
+    temp.reserve(_size);
+    for (int i = 0; i < _size; i++) {
+        temp.push_back(i); // Dodanie każdego wierzchołka do permutacji.
+    }
+    std::shuffle(temp.begin(), temp.end(), rng); // Mieszanie permutacji własnym generatorem solvera.
+    return temp;
+}
+
+// Oblicza koszt danej ścieżki w grafie (Moves.h).
+int TabuSearch::calculatePath(const std::vector<int>& path) const {
+    return tourCost(matrix, path);
+}
+
+// Generuje początkową ścieżkę metodą zachłanną: najlepszą z tras najbliższego sąsiada
+// z wielu startów (Greedy.h), budowanych na puli przeglądu, jeśli jest włączona.
+std::vector<int> TabuSearch::greedyPath() {
+    return bestGreedyTour(matrix, pool.get());
+}
+
+TabuSearch::~TabuSearch()
+{
+}
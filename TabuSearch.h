@@ -1,19 +1,70 @@
-#include <vector>
-#include "adjacency_matrix.h" // Include the Adjacency_Matrix header
-
-class TabuSearch
-{
-private:
-    std::vector<std::vector<int>> matrix; // Use a 2D vector for the matrix
-    int size = 0;
-    int searchTime = 0;
-
-    std::vector<int> randomPermutation(int _size);
-    int calculatePath(std::vector<int> path);
-
-public:
-    void apply();
-    TabuSearch(Adjacency_Matrix graph, int time); // Constructor now takes Adjacency_Matrix
-    ~TabuSearch();
-    std::vector<int> greedyPath();
-};
+#include <memory>
+#include <random>
+#include <vector>
+#include "adjacency_matrix.h" // Include the Adjacency_Matrix header
+#include "Checkpoint.h"
+#include "Deadline.h"
+#include "LocalSearch.h"
+#include "Neighborhood.h"
+#include "SearchContext.h"
+#include "TabuList.h"
+#include "WorkerPool.h"
+
+class TabuSearch
+{
+private:
+    MatrixView matrix; // Non-owning view of the graph's distance matrix
+    int size = 0;
+    double searchTime = 0;
+    Random rng; // Per-solver random stream, so instances can run on separate threads
+    std::unique_ptr<WorkerPool> pool; // Threads sharing each step's swap scan (null = sequential)
+    Neighborhood neighborhood; // Move set scanned in each step (FullSwap = exhaustive pair swap)
+    std::unique_ptr<LocalSearch> polish; // Optional Or-opt/or-3opt descent on the best tour (null = off)
+    double polishInterval = 0; // Seconds between polishing the incumbent (0 = only the final tour)
+    SolverStats stats; // Counters of the last run (only filled when built with PEA_TELEMETRY)
+    TabuList tabu; // Forbidden move attributes with absolute expiry iterations
+    int tenure = 0; // Iterations a reversed move stays tabu (0 = number of vertices)
+    std::vector<int> initialTour; // Starting tour given from outside (empty = greedy best, random current)
+    std::string checkpointPath; // Run state file (empty = no checkpoints)
+    double checkpointInterval = 0; // Seconds between checkpoints (0 = only at the end of the run)
+    std::unique_ptr<Checkpoint> resumed; // State loaded by resume(), consumed by the next solve()
+
+    // Best moves found in a range of rows of one step's swap scan
+    struct MoveScan {
+        int bestCost = INT_MAX; Move bestMove; // Best move overall (new global best candidate)
+        int nextCost = INT_MAX; Move nextMove; // Best non-tabu move
+        long long evaluated = 0; // Moves evaluated in the range
+        long long tabuBlocked = 0; // Tabu moves that beat the best allowed move seen so far
+        bool expired = false; // The time limit was hit before the range was finished
+        void merge(const MoveScan& other);
+    };
+
+    std::vector<int> randomPermutation(int _size);
+    int calculatePath(const std::vector<int>& path) const;
+    void scanRows(int from, int to, const std::vector<int>& permutation, int currentCost, long long iteration,
+                  int aspiration, const Deadline& deadline, MoveScan& scan);
+    void scanNeighborhood(const std::vector<int>& permutation, const std::vector<int>& position, int currentCost,
+                          long long iteration, int aspiration, MoveScan& scan);
+    uint64_t tabuKey(const Move& move, const std::vector<int>& permutation) const; // Attribute made tabu by an applied move
+    uint64_t edgeKey(int from, int to) const;
+    bool isTabu(const Move& move, const std::vector<int>& permutation, long long iteration) const;
+    void saveState(const std::vector<int>& best, int bestCost, const std::vector<int>& permutation,
+                   long long iteration, long long evaluations, long long idle, int restartBest);
+    bool polishBest(std::vector<int>& best, int& cost, double& foundTime, Deadline& deadline, bool limited,
+                    const SearchContext& context);
+
+public:
+    void apply();
+    Tour solve(const SearchContext& context = SearchContext()); // Runs the search without printing
+    TabuSearch(const Adjacency_Matrix& graph, double time, uint64_t seed = std::random_device()()); // The graph must outlive the solver
+    ~TabuSearch();
+    void setScanThreads(int threads); // Splits each step's swap scan across threads on large instances
+    void setNeighborhood(const Neighborhood& moves); // Candidate-list neighborhood instead of the full swap scan
+    void setPolish(std::shared_ptr<const CandidateLists> lists, double interval); // Local search on the best tour every interval seconds (0 = final tour only)
+    void setTenure(int iterations); // Tabu tenure in iterations (0 = number of vertices)
+    bool setInitialTour(const std::vector<int>& tour); // Start from this tour instead of the greedy one
+    void setCheckpoint(const std::string& path, double interval); // Save the run state every interval s and at the end
+    bool resume(const std::string& path); // The next solve() continues the run saved in path
+    std::vector<int> greedyPath();
+    const SolverStats& statistics() const { return stats; }
+};
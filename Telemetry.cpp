@@ -0,0 +1,39 @@
+#include "Telemetry.h"
+#include "AllocationCounter.h"
+
+void TelemetrySink::snapshot(const char* solver, int worker, double time, const SolverStats& stats,
+                             int currentCost, int bestCost) {
+    write("snapshot", solver, worker, time, stats, currentCost, bestCost, false);
+}
+
+void TelemetrySink::finish(const char* solver, int worker, double time, const SolverStats& stats, int bestCost) {
+    write("final", solver, worker, time, stats, -1, bestCost, true);
+}
+
+// Cały wiersz zapisywany jest pod blokadą, więc wiersze różnych wątków się nie przeplatają.
+void TelemetrySink::write(const char* type, const char* solver, int worker, double time, const SolverStats& stats,
+                          int currentCost, int bestCost, bool trace) {
+    std::lock_guard<std::mutex> lock(mutex);
+    fprintf(out, "{\"type\":\"%s\",\"solver\":\"%s\",\"worker\":%d,\"time\":%.6f,\"iterations\":%lld,"
+                 "\"evaluations\":%lld,\"evaluations_per_second\":%.0f,\"accepted\":%lld,\"rejected\":%lld,"
+                 "\"tabu_blocked\":%lld,\"restarts\":%lld,\"exchanges\":%lld,\"temperature\":%.6g,\"improvements\":%zu,",
+            type, solver, worker, time, stats.iterations, stats.evaluations,
+            time > 0 ? stats.evaluations / time : 0.0, stats.accepted, stats.rejected,
+            stats.tabuBlocked, stats.restarts, stats.exchanges, stats.temperature, stats.improvements.size());
+    if (ALLOCATION_COUNTING) {
+        fprintf(out, "\"allocations\":%lld,", stats.allocations);
+    }
+    if (currentCost >= 0) {
+        fprintf(out, "\"current_cost\":%d,", currentCost);
+    }
+    fprintf(out, "\"best_cost\":%d", bestCost);
+    if (trace) {
+        fprintf(out, ",\"trace\":[");
+        for (size_t i = 0; i < stats.improvements.size(); i++) {
+            fprintf(out, "%s[%.6f,%d]", i > 0 ? "," : "", stats.improvements[i].first, stats.improvements[i].second);
+        }
+        fprintf(out, "]");
+    }
+    fprintf(out, "}\n");
+    fflush(out);
+}
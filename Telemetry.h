@@ -0,0 +1,58 @@
+#ifndef PEA2_TELEMETRY_H
+#define PEA2_TELEMETRY_H
+
+#include <cstdio>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Liczniki przebiegu są wkompilowane tylko przy PEA_TELEMETRY (opcja CMake). Warunki
+// if (TELEMETRY_ENABLED) są stałymi czasu kompilacji, więc po wyłączeniu inkrementacje
+// i zapisy migawek znikają z gorących pętli całkowicie.
+#ifdef PEA_TELEMETRY
+constexpr bool TELEMETRY_ENABLED = true;
+#else
+constexpr bool TELEMETRY_ENABLED = false;
+#endif
+
+// Statystyki jednego przebiegu solvera. Każdy solver (a więc każdy wątek) ma własną
+// kopię zwykłych liczników - bez blokad i bez atomików w gorącej pętli.
+struct SolverStats {
+    long long iterations = 0;  // TS: kroki, SA: losowane ruchy.
+    long long evaluations = 0; // Ocenione ruchy (sąsiedzi).
+    long long accepted = 0;    // Wykonane ruchy.
+    long long rejected = 0;    // TS: kroki bez dozwolonego ruchu, SA: ruchy odrzucone przez Metropolisa.
+    long long tabuBlocked = 0; // Ruchy tabu lepsze od najlepszego dotąd dozwolonego w kroku.
+    long long restarts = 0;    // TS: nowe losowe permutacje, SA: powroty do temperatury początkowej.
+    long long exchanges = 0;   // PT: przyjęte zamiany stanów między sąsiednimi temperaturami.
+    long long allocations = 0; // Alokacje sterty w pętli głównej (tylko przy PEA_COUNT_ALLOCATIONS).
+    double temperature = 0;    // Bieżąca temperatura SA (PT: najniższa temperatura drabiny).
+    std::vector<std::pair<double, int>> improvements; // Ślad poprawy najlepszego wyniku: (sekundy, koszt).
+
+    void improved(double time, int cost) {
+        if (TELEMETRY_ENABLED) improvements.emplace_back(time, cost);
+    }
+};
+
+// Odbiorca migawek w formacie JSON lines (jeden obiekt na wiersz). Solvery wysyłają migawkę
+// co interval() sekund oraz podsumowanie ze śladem popraw na końcu przebiegu. Migawki są
+// rzadkie, więc zapis do wspólnego pliku chroni zwykły mutex.
+class TelemetrySink {
+public:
+    explicit TelemetrySink(FILE* out, double interval = 1.0) : out(out), period(interval) {
+    }
+    double interval() const {
+        return period;
+    }
+    void snapshot(const char* solver, int worker, double time, const SolverStats& stats, int currentCost, int bestCost);
+    void finish(const char* solver, int worker, double time, const SolverStats& stats, int bestCost);
+private:
+    FILE* out;
+    double period;
+    std::mutex mutex;
+
+    void write(const char* type, const char* solver, int worker, double time, const SolverStats& stats,
+               int currentCost, int bestCost, bool trace);
+};
+
+#endif // PEA2_TELEMETRY_H
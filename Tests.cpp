@@ -0,0 +1,210 @@
+// Testy poprawności uruchamiane przez ctest (osobny program Pea2Tests).
+//
+// Każdy test porównuje szybki kod z prostą implementacją odniesienia na wielu losowych
+// przypadkach ze stałych ziaren: solvery dokładne z przeglądem zupełnym, jądro
+// nearestUnvisited z pętlą skalarną, a listę tabu z mapą klucz -> koniec zakazu.
+// Argument wybiera jeden test (exact, nearest, tabu); bez argumentu uruchamiane są wszystkie.
+// Kod wyjścia 1 oznacza, że któreś porównanie się nie zgodziło.
+
+#include "adjacency_matrix.h"
+#include "ExactSolver.h"
+#include "Greedy.h"
+#include "Moves.h"
+#include "Random.h"
+#include "TabuList.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const string& message) {
+    if (!condition) {
+        fprintf(stderr, "BLAD: %s\n", message.c_str());
+        failures++;
+    }
+}
+
+// Koszt optymalnej trasy przez przegląd wszystkich permutacji z wierzchołkiem 0 na początku.
+int bruteForceOptimum(const MatrixView& matrix) {
+    vector<int> path(matrix.size());
+    for (int i = 0; i < matrix.size(); i++) path[i] = i;
+    int best = INT_MAX;
+    do {
+        best = min(best, tourCost(matrix, path));
+    } while (next_permutation(path.begin() + 1, path.end()));
+    return best;
+}
+
+bool isPermutation(const vector<int>& path, int n) {
+    vector<char> seen(n, 0);
+    for (int v : path) {
+        if (v < 0 || v >= n || seen[v]) return false;
+        seen[v] = 1;
+    }
+    return (int)path.size() == n;
+}
+
+// Held-Karp (jeden i kilka wątków) oraz podział i ograniczenia na instancjach do 9 miast.
+// Wagi z małego zakresu dają wiele tras o tym samym koszcie, a stałe wagi - same remisy.
+void testExact() {
+    Random rng(20);
+    const int ranges[] = {100, 2, 1};
+    for (int n = 3; n <= 9; n++) {
+        for (int range : ranges) {
+            for (int repeat = 0; repeat < 3; repeat++) {
+                vector<int> weights((size_t)n * n);
+                for (int i = 0; i < n; i++) {
+                    for (int j = 0; j < n; j++) {
+                        weights[(size_t)i * n + j] = i == j ? 100000000 : 1 + (int)rng.below(range);
+                    }
+                }
+                Adjacency_Matrix graph;
+                graph.assign(weights.data(), n);
+                const int optimum = bruteForceOptimum(graph.getView());
+                const string instance = "n=" + to_string(n) + " wagi 1.." + to_string(range);
+
+                const ExactMethod methods[] = {ExactMethod::HeldKarp, ExactMethod::HeldKarp, ExactMethod::BranchAndBound};
+                const int threads[] = {1, 3, 1};
+                const char* names[] = {"Held-Karp", "Held-Karp (3 watki)", "podzial i ograniczenia"};
+                for (int m = 0; m < 3; m++) {
+                    ExactSolver solver(graph, 10);
+                    solver.setMethod(methods[m]);
+                    solver.setThreads(threads[m]);
+                    Tour tour = solver.solve();
+                    const string label = string(names[m]) + ", " + instance;
+                    check(solver.proven(), label + ": brak dowodu optymalnosci");
+                    check(tour.cost == optimum,
+                          label + ": koszt " + to_string(tour.cost) + ", optimum " + to_string(optimum));
+                    check(isPermutation(tour.path, n) && tourCost(graph.getView(), tour.path) == tour.cost,
+                          label + ": trasa nie zgadza sie z kosztem");
+                }
+            }
+        }
+    }
+}
+
+// Odniesienie dla nearestUnvisited: najmniejsze max(waga, maska) mniejsze od INT32_MAX,
+// przy remisie najmniejszy indeks.
+int nearestReference(const Weight* row, const int32_t* mask, int n) {
+    int nearest = -1;
+    int bestValue = INT32_MAX;
+    for (int j = 0; j < n; j++) {
+        const int value = max((int32_t)row[j], mask[j]);
+        if (value < bestValue) {
+            bestValue = value;
+            nearest = j;
+        }
+    }
+    return nearest;
+}
+
+// Jądro wektorowe (AVX2, jeśli procesor je ma) na wierszach różnej długości, także
+// przesuniętych względem wyrównania, z remisami, wagą maksymalną i wagami ujemnymi.
+void testNearest() {
+    Random rng(14);
+    for (int n = 0; n <= 80; n++) {
+        for (int offset = 0; offset < 3; offset++) {
+            for (int repeat = 0; repeat < 20; repeat++) {
+                vector<Weight> weights(n + offset);
+                vector<int32_t> masks(n + offset);
+                Weight* row = weights.data() + offset;
+                int32_t* mask = masks.data() + offset;
+                const uint32_t range = repeat % 2 == 0 ? 4 : 1000;
+                const uint32_t visited = repeat % 5; // Od żadnego do ok. 4/5 odwiedzonych.
+                for (int j = 0; j < n; j++) {
+                    const uint32_t kind = rng.below(20);
+                    row[j] = kind == 0 ? (Weight)WEIGHT_MAX : kind == 1 ? (Weight)-1 : (Weight)rng.below(range);
+                    mask[j] = rng.below(5) < visited ? VISITED : UNVISITED;
+                }
+                const int expected = nearestReference(row, mask, n);
+                const int actual = nearestUnvisited(row, mask, n);
+                check(actual == expected, "nearestUnvisited n=" + to_string(n) + " przesuniecie " + to_string(offset)
+                                              + ": " + to_string(actual) + ", oczekiwano " + to_string(expected));
+            }
+        }
+    }
+}
+
+// Porównuje wszystkie klucze z zakresu z modelem w iteracji iteration.
+void compareTabu(const TabuList& tabu, const map<uint64_t, long long>& model, const vector<uint64_t>& keys,
+                 long long iteration, const string& label) {
+    for (uint64_t key : keys) {
+        auto entry = model.find(key);
+        const bool expected = entry != model.end() && entry->second > iteration;
+        if (tabu.isTabu(key, iteration) != expected) {
+            check(false, label + ": klucz " + to_string(key) + " w iteracji " + to_string(iteration));
+            return;
+        }
+    }
+}
+
+// Lista tabu z co najwyżej jednym zakazem na iterację (jak w TS) kontra model: zakaz dodany
+// w iteracji t obowiązuje w iteracjach t+1..t+tenure. Klucze z małego zbioru powtarzają się
+// (przedłużanie zakazów), a wielokrotności 2^shift zderzają się w tablicy haszującej.
+void testTabu() {
+    Random rng(15);
+    vector<uint64_t> keys;
+    for (uint64_t k = 0; k < 48; k++) keys.push_back(k);
+    for (uint64_t k = 1; k <= 16; k++) keys.push_back(k << 40);
+    const int tenures[] = {1, 2, 7, 30};
+    for (int tenure : tenures) {
+        const string label = "TabuList tenure=" + to_string(tenure);
+        TabuList tabu(tenure);
+        map<uint64_t, long long> model;
+        long long iteration = 0;
+        for (int step = 0; step < 3000; step++) {
+            iteration += 1 + (rng.below(4) == 0 ? rng.below(tenure + 2) : 0);
+            compareTabu(tabu, model, keys, iteration, label);
+            const uint64_t key = keys[rng.below((uint32_t)keys.size())];
+            tabu.add(key, iteration);
+            model[key] = iteration + tenure + 1;
+            if (rng.below(500) == 0) {
+                tabu.clear();
+                model.clear();
+                compareTabu(tabu, model, keys, iteration + 1, label + " po clear()");
+            }
+            if (rng.below(100) == 0) {
+                // Odtworzenie z entries() daje listę zachowującą się tak samo dalej.
+                TabuList restored(tenure);
+                restored.restore(tabu.entries());
+                compareTabu(restored, model, keys, iteration + 1, label + " po restore()");
+                tabu = restored;
+            }
+        }
+        compareTabu(tabu, model, keys, iteration + tenure + 1, label + " po wygasnieciu");
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    const string only = argc > 1 ? argv[1] : "";
+    bool known = false;
+    if (only.empty() || only == "exact") {
+        testExact();
+        known = true;
+    }
+    if (only.empty() || only == "nearest") {
+        testNearest();
+        known = true;
+    }
+    if (only.empty() || only == "tabu") {
+        testTabu();
+        known = true;
+    }
+    if (!known) {
+        fprintf(stderr, "Uzycie: Pea2Tests [exact|nearest|tabu]\n");
+        return 1;
+    }
+    printf("%s: %d bledow\n", only.empty() ? "wszystkie testy" : only.c_str(), failures);
+    return failures == 0 ? 0 : 1;
+}
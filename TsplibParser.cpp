@@ -0,0 +1,305 @@
+#include "TsplibParser.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include "WorkerPool.h"
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+std::string trim(const char* from, const char* to) {
+    while (from < to && isSpace(*from)) from++;
+    while (to > from && isSpace(to[-1])) to--;
+    return std::string(from, to);
+}
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Funkcje odległości zgodne ze specyfikacją TSPLIB.
+const double PI = 3.141592;
+const double EARTH_RADIUS = 6378.388;
+
+double geoRadians(double value) {
+    int degrees = (int)value;
+    double minutes = value - degrees;
+    return PI * (degrees + 5.0 * minutes / 3.0) / 180.0;
+}
+
+int euclidean(double dx, double dy) {
+    return (int)(std::sqrt(dx * dx + dy * dy) + 0.5);
+}
+
+int ceilEuclidean(double dx, double dy) {
+    return (int)std::ceil(std::sqrt(dx * dx + dy * dy));
+}
+
+int pseudoEuclidean(double dx, double dy) {
+    double r = std::sqrt((dx * dx + dy * dy) / 10.0);
+    int t = (int)(r + 0.5);
+    return t < r ? t + 1 : t;
+}
+
+int geographic(double latitudeA, double longitudeA, double latitudeB, double longitudeB) {
+    double q1 = std::cos(longitudeA - longitudeB);
+    double q2 = std::cos(latitudeA - latitudeB);
+    double q3 = std::cos(latitudeA + latitudeB);
+    return (int)(EARTH_RADIUS * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+}
+
+std::string weightRangeError(long long value) {
+    return "waga " + std::to_string(value) + " poza zakresem typu wag (maksymalnie " + std::to_string(WEIGHT_MAX) + ")";
+}
+
+// Wypełnia macierz n x n wagami distance(i, j) (0 na przekątnej). Funkcja odległości jest
+// parametrem szablonu, więc rodzaj odległości wybierany jest raz, a nie dla każdej pary.
+// Wiersze są niezależne i liczone równolegle na puli, jeśli podano. Zwraca false (i w tooLarge
+// jedną z odległości), jeśli któraś nie mieści się w typie Weight.
+template <typename Distance>
+bool fillRows(int n, Weight* data, int stride, WorkerPool* pool, Distance distance, long long& tooLarge) {
+    const int tasks = pool != nullptr ? pool->size() : 1;
+    std::atomic<long long> overflow{0};
+    const std::function<void(int)> fill = [&](int task) {
+        for (int i = task; i < n && overflow.load(std::memory_order_relaxed) == 0; i += tasks) {
+            Weight* row = data + (size_t)i * stride;
+            for (int j = 0; j < n; j++) {
+                long long d = i == j ? 0 : distance(i, j);
+                if (!fitsWeight(d)) {
+                    overflow.store(d, std::memory_order_relaxed);
+                    return;
+                }
+                row[j] = (Weight)d;
+            }
+        }
+    };
+    if (pool != nullptr) {
+        pool->run(tasks, fill);
+    } else {
+        fill(0);
+    }
+    tooLarge = overflow.load();
+    return tooLarge == 0;
+}
+
+}
+
+TsplibParser::TsplibParser(const char* text, size_t length) : cursor(text), end(text + length) {
+}
+
+bool TsplibParser::fail(const std::string& message) {
+    error = message;
+    return false;
+}
+
+void TsplibParser::skipSpaces() {
+    while (cursor < end && isSpace(*cursor)) cursor++;
+}
+
+// Czyta linie "KLUCZ : wartość" aż do pierwszego słowa kończącego się na _SECTION.
+bool TsplibParser::readHeader(TsplibHeader& header) {
+    while (true) {
+        skipSpaces();
+        if (cursor >= end) {
+            return fail("brak sekcji danych w pliku");
+        }
+        const char* lineEnd = cursor;
+        while (lineEnd < end && *lineEnd != '\n') lineEnd++;
+        const char* colon = cursor;
+        while (colon < lineEnd && *colon != ':') colon++;
+        std::string key = trim(cursor, colon);
+        std::string value = colon < lineEnd ? trim(colon + 1, lineEnd) : std::string();
+        cursor = lineEnd;
+
+        if (endsWith(key, "_SECTION")) {
+            header.section = key;
+            return header.dimension > 0 || fail("brak lub niepoprawny wymiar DIMENSION");
+        }
+        if (key == "EOF") {
+            return fail("brak sekcji danych w pliku");
+        }
+        if (key == "NAME") header.name = value;
+        else if (key == "TYPE") header.type = value;
+        else if (key == "COMMENT") header.comment = value;
+        else if (key == "DIMENSION") header.dimension = std::atoi(value.c_str());
+        else if (key == "EDGE_WEIGHT_TYPE") header.edgeWeightType = value;
+        else if (key == "EDGE_WEIGHT_FORMAT") header.edgeWeightFormat = value;
+        // Pozostałe słowa kluczowe (CAPACITY, NODE_COORD_TYPE, DISPLAY_DATA_TYPE...) są pomijane.
+    }
+}
+
+bool TsplibParser::readWeights(const TsplibHeader& header, Weight* data, int stride, WorkerPool* pool) {
+    if (header.edgeWeightType == "EXPLICIT") {
+        if (header.section != "EDGE_WEIGHT_SECTION") {
+            return fail("oczekiwano EDGE_WEIGHT_SECTION, znaleziono " + header.section);
+        }
+        return readExplicit(header, data, stride);
+    }
+    if (header.section != "NODE_COORD_SECTION") {
+        return fail("oczekiwano NODE_COORD_SECTION, znaleziono " + header.section);
+    }
+    return readCoordinates(header, data, stride, pool);
+}
+
+bool TsplibParser::readExplicit(const TsplibHeader& header, Weight* data, int stride) {
+    const int n = header.dimension;
+    std::string format = header.edgeWeightFormat.empty() ? "FULL_MATRIX" : header.edgeWeightFormat;
+    long long value;
+    if (format == "FULL_MATRIX") {
+        for (int i = 0; i < n; i++) {
+            Weight* row = data + (size_t)i * stride;
+            for (int j = 0; j < n; j++) {
+                if (!readInt(value)) return false;
+                if (j != i && !fitsWeight(value)) return fail(weightRangeError(value));
+                row[j] = clampWeight(value);
+            }
+        }
+        return true;
+    }
+
+    // Formaty trójkątne opisują macierz symetryczną. Wersje kolumnowe są zapisem
+    // przeciwnego trójkąta wierszami, więc sprowadzamy je do formatów wierszowych.
+    bool upper, diagonal;
+    if (format == "UPPER_ROW" || format == "LOWER_COL") { upper = true; diagonal = false; }
+    else if (format == "LOWER_ROW" || format == "UPPER_COL") { upper = false; diagonal = false; }
+    else if (format == "UPPER_DIAG_ROW" || format == "LOWER_DIAG_COL") { upper = true; diagonal = true; }
+    else if (format == "LOWER_DIAG_ROW" || format == "UPPER_DIAG_COL") { upper = false; diagonal = true; }
+    else return fail("nieobslugiwany EDGE_WEIGHT_FORMAT: " + format);
+
+    for (int i = 0; i < n; i++) {
+        data[(size_t)i * stride + i] = 0;
+    }
+    for (int i = 0; i < n; i++) {
+        int from = upper ? (diagonal ? i : i + 1) : 0;
+        int to = upper ? n : (diagonal ? i + 1 : i);
+        for (int j = from; j < to; j++) {
+            if (!readInt(value)) return false;
+            if (j != i && !fitsWeight(value)) return fail(weightRangeError(value));
+            Weight w = clampWeight(value);
+            data[(size_t)i * stride + j] = w;
+            data[(size_t)j * stride + i] = w;
+        }
+    }
+    return true;
+}
+
+bool TsplibParser::readCoordinates(const TsplibHeader& header, Weight* data, int stride, WorkerPool* pool) {
+    const int n = header.dimension;
+    const std::string& type = header.edgeWeightType;
+    if (type != "EUC_2D" && type != "CEIL_2D" && type != "GEO" && type != "ATT") {
+        return fail("nieobslugiwany EDGE_WEIGHT_TYPE: " + type);
+    }
+    std::vector<double> x(n), y(n);
+    for (int k = 0; k < n; k++) {
+        long long index;
+        double px, py;
+        if (!readInt(index) || !readDouble(px) || !readDouble(py)) return false;
+        if (index < 1 || index > n) {
+            return fail("numer wierzcholka poza zakresem w NODE_COORD_SECTION");
+        }
+        x[index - 1] = px;
+        y[index - 1] = py;
+    }
+    if (type == "GEO") {
+        // Współrzędne GEO to szerokość i długość geograficzna w formacie DDD.MM.
+        for (int k = 0; k < n; k++) {
+            x[k] = geoRadians(x[k]);
+            y[k] = geoRadians(y[k]);
+        }
+    }
+    long long tooLarge = 0;
+    bool filled;
+    if (type == "EUC_2D") {
+        filled = fillRows(n, data, stride, pool, [&](int i, int j) { return euclidean(x[i] - x[j], y[i] - y[j]); },
+                          tooLarge);
+    } else if (type == "CEIL_2D") {
+        filled = fillRows(n, data, stride, pool,
+                          [&](int i, int j) { return ceilEuclidean(x[i] - x[j], y[i] - y[j]); }, tooLarge);
+    } else if (type == "ATT") {
+        filled = fillRows(n, data, stride, pool,
+                          [&](int i, int j) { return pseudoEuclidean(x[i] - x[j], y[i] - y[j]); }, tooLarge);
+    } else {
+        filled = fillRows(n, data, stride, pool, [&](int i, int j) { return geographic(x[i], y[i], x[j], y[j]); },
+                          tooLarge);
+    }
+    return filled || fail(weightRangeError(tooLarge));
+}
+
+bool TsplibParser::readInt(long long& value) {
+    skipSpaces();
+    const char* start = cursor;
+    bool negative = false;
+    if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+        negative = *cursor == '-';
+        cursor++;
+    }
+    if (cursor >= end || *cursor < '0' || *cursor > '9') {
+        return fail("oczekiwano liczby calkowitej");
+    }
+    long long result = 0;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+        result = result * 10 + (*cursor - '0');
+        cursor++;
+    }
+    if (cursor < end && (*cursor == '.' || *cursor == 'e' || *cursor == 'E')) {
+        // Waga zapisana jako liczba rzeczywista - czytamy ją ponownie i zaokrąglamy.
+        cursor = start;
+        double real;
+        if (!readDouble(real)) return false;
+        value = std::llround(real);
+        return true;
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+bool TsplibParser::readDouble(double& value) {
+    skipSpaces();
+    bool negative = false;
+    if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+        negative = *cursor == '-';
+        cursor++;
+    }
+    bool digits = false;
+    double result = 0.0;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+        result = result * 10.0 + (*cursor - '0');
+        cursor++;
+        digits = true;
+    }
+    if (cursor < end && *cursor == '.') {
+        cursor++;
+        double scale = 0.1;
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+            result += (*cursor - '0') * scale;
+            scale *= 0.1;
+            cursor++;
+            digits = true;
+        }
+    }
+    if (!digits) {
+        return fail("oczekiwano liczby");
+    }
+    if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+        cursor++;
+        bool negativeExponent = false;
+        if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+            negativeExponent = *cursor == '-';
+            cursor++;
+        }
+        int exponent = 0;
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+            exponent = exponent * 10 + (*cursor - '0');
+            cursor++;
+        }
+        result *= std::pow(10.0, negativeExponent ? -exponent : exponent);
+    }
+    value = negative ? -result : result;
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef PEA2_TSPLIB_PARSER_H
+#define PEA2_TSPLIB_PARSER_H
+
+#include <cstddef>
+#include <string>
+#include "DistanceMatrix.h"
+
+class WorkerPool;
+
+// Słowa kluczowe nagłówka pliku TSPLIB.
+struct TsplibHeader {
+    std::string name;
+    std::string type;
+    std::string comment;
+    std::string edgeWeightType;
+    std::string edgeWeightFormat;
+    std::string section; // Sekcja danych, na której zakończył się nagłówek.
+    int dimension = 0;
+};
+
+// Strumieniowy parser formatu TSPLIB działający na buforze tekstu (np. zmapowanym pliku).
+// Obsługuje macierze jawne (FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW,
+// LOWER_DIAG_ROW i odpowiedniki kolumnowe) oraz współrzędne EUC_2D, CEIL_2D, GEO i ATT.
+// Liczby czytane są ręcznym skanerem, bez iostreamów. Macierz ze współrzędnych może być
+// liczona równolegle na puli wątków.
+class TsplibParser {
+public:
+    TsplibParser(const char* text, size_t length);
+    bool readHeader(TsplibHeader& header);
+    bool readWeights(const TsplibHeader& header, Weight* data, int stride, WorkerPool* pool = nullptr);
+    const std::string& getError() const { return error; }
+private:
+    const char* cursor;
+    const char* end;
+    std::string error;
+
+    bool readExplicit(const TsplibHeader& header, Weight* data, int stride);
+    bool readCoordinates(const TsplibHeader& header, Weight* data, int stride, WorkerPool* pool);
+    bool readInt(long long& value);
+    bool readDouble(double& value);
+    void skipSpaces();
+    bool fail(const std::string& message);
+};
+
+#endif // PEA2_TSPLIB_PARSER_H
@@ -0,0 +1,70 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(int threads) {
+    for (int i = 1; i < threads; i++) {
+        workers.emplace_back(&WorkerPool::workLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::run(int tasks, const std::function<void(int)>& job) {
+    if (workers.empty() || tasks <= 1) {
+        for (int task = 0; task < tasks; task++) {
+            job(task);
+        }
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = &job;
+        taskCount = tasks;
+        nextTask.store(0, std::memory_order_relaxed);
+        busy = (int)workers.size();
+        generation++;
+    }
+    wake.notify_all();
+    drain(); // Wątek wywołujący też pobiera zadania.
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return busy == 0; });
+    current = nullptr;
+}
+
+// Pobiera i wykonuje zadania bieżącego zlecenia, dopóki jakieś zostały.
+void WorkerPool::drain() {
+    while (true) {
+        int task = nextTask.fetch_add(1, std::memory_order_relaxed);
+        if (task >= taskCount) {
+            return;
+        }
+        (*current)(task);
+    }
+}
+
+void WorkerPool::workLoop() {
+    unsigned seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seen]() { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        drain();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) {
+            done.notify_one();
+        }
+    }
+}
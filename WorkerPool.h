@@ -0,0 +1,39 @@
+#ifndef PEA2_WORKER_POOL_H
+#define PEA2_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Stała pula wątków do równoległości typu fork-join. run() rozdziela zadania 0..tasks-1
+// między wątki puli i wątek wywołujący, a wraca dopiero po wykonaniu wszystkich.
+// Wątki są tworzone raz, więc pojedyncze wywołanie kosztuje tylko wybudzenie puli.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threads);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void run(int tasks, const std::function<void(int)>& job);
+    int size() const { return (int)workers.size() + 1; }
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(int)>* current = nullptr;
+    std::atomic<int> nextTask{0};
+    int taskCount = 0;
+    int busy = 0;          // Wątki puli, które jeszcze pracują nad bieżącym zleceniem.
+    unsigned generation = 0;
+    bool stopping = false;
+
+    void workLoop();
+    void drain();
+};
+
+#endif // PEA2_WORKER_POOL_H
@@ -1,75 +1,136 @@
-#include "adjacency_matrix.h"
-
-#include <iostream>
-
-using namespace std;
-
-Adjacency_Matrix::Adjacency_Matrix() {
-}
-
-void Adjacency_Matrix::printMatrix()
-{
-    for (int i = 0; i < matrix.size(); i++) {
-        for (int j = 0; j < matrix[i].size(); j++)
-            cout << matrix[i][j] << " ";
-        cout << endl;
-    }
-}
-void Adjacency_Matrix::loadFromFile(const string& filename){
-    matrix.clear();
-    string dump,opis="";
-    ifstream plik(filename);
-    int wagi;
-    if (plik.is_open()) {
-        getline(plik,dump);
-        opis.append(dump+"\n");
-        getline(plik,dump);
-        opis.append(dump+"\n");
-        getline(plik,dump);
-        opis.append(dump+"\n");
-        getline(plik,dump, ' ');
-        opis.append(dump+"\n");
-        plik >> liczbaWierzcholkow;
-        getline(plik,dump);
-        opis.append(dump+"\n");
-        getline(plik,dump);
-        opis.append(dump+"\n");
-        getline(plik,dump);
-        opis.append(dump+"\n");
-        getline(plik,dump);
-        opis.append(dump+"\n");
-        // Plik został otwarty pomyślnie, możesz kontynuować operacje na pliku.
-        vector<int> wiersz;
-        for (int j = 0; j < liczbaWierzcholkow; j++){
-            for (int i = 0; i < liczbaWierzcholkow; i++){
-                plik >> wagi;
-                wiersz.push_back(wagi);
-            }
-            matrix.push_back(wiersz);
-            wiersz.clear();
-        }
-    } else {
-        cout << "Nie udało się otworzyć pliku.";
-    }
-}
-void Adjacency_Matrix::generate(int numberOfNodes){
-    matrix.clear();
-    srand(time(NULL));
-    vector<int> wiersz;
-    for (int j = 0; j < numberOfNodes; j++){
-        for (int i = 0; i < numberOfNodes; i++) {
-            if(i==j)
-                wiersz.push_back(-1);
-            else wiersz.push_back((rand() % 101) + 1);
-        }
-        matrix.push_back(wiersz);
-        wiersz.clear();
-    }
-
-}
-vector<vector<int>> Adjacency_Matrix::getMatrix() {
-    return matrix;
-}
-int Adjacency_Matrix::getNumVertices() {
-    return liczbaWierzcholkow;
-}
+#include "adjacency_matrix.h"
+#include "Generator.h"
+#include "InstanceCache.h"
+#include "Random.h"
+#include "MappedFile.h"
+#include "TsplibParser.h"
+
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+
+using namespace std;
+
+Adjacency_Matrix::Adjacency_Matrix() {
+}
+
+// Pusty deleter: bufor należy do wywołującego, obiekt tylko go udostępnia solverom.
+Adjacency_Matrix::Adjacency_Matrix(const MatrixView& view)
+    : storage(view.data, [](const Weight*) {}), liczbaWierzcholkow(view.n), stride(view.stride) {
+}
+
+// Przydziela wyrównany bufor na macierz n x n. Dopełnienie wierszy wypełniane jest
+// maksymalną wagą, dzięki czemu nigdy nie wygrywa przy szukaniu minimum w wierszu.
+Weight* Adjacency_Matrix::allocate(int numberOfNodes) {
+    liczbaWierzcholkow = numberOfNodes;
+    stride = paddedStride(numberOfNodes);
+    size_t count = (size_t)numberOfNodes * stride;
+    Weight* data = static_cast<Weight*>(::operator new(max(count, (size_t)1) * sizeof(Weight), align_val_t(MATRIX_ALIGNMENT)));
+    storage = shared_ptr<Weight>(data, [](Weight* p) { ::operator delete(p, align_val_t(MATRIX_ALIGNMENT)); });
+    fill(data, data + count, (Weight)WEIGHT_MAX);
+    return data;
+}
+
+void Adjacency_Matrix::printMatrix()
+{
+    MatrixView matrix = getView();
+    for (int i = 0; i < matrix.n; i++) {
+        for (int j = 0; j < matrix.n; j++)
+            cout << matrix(i, j) << " ";
+        cout << endl;
+    }
+}
+// Wczytuje instancję w formacie TSPLIB (ATSP/TSP). Plik jest mapowany do pamięci
+// i parsowany bez iostreamów; nagłówek jest czytany po słowach kluczowych.
+// Jeśli obok leży aktualna kopia binarna, macierz jest z niej mapowana bez parsowania;
+// w przeciwnym razie kopia jest zapisywana po udanym wczytaniu tekstu. Plik ".bin"
+// (np. z generatora) jest mapowany bezpośrednio.
+bool Adjacency_Matrix::loadFromFile(const string& filename, WorkerPool* pool){
+    if (readInstanceCache(filename, storage, liczbaWierzcholkow, stride)) {
+        return true;
+    }
+    if (filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0) {
+        if (readInstanceBinary(filename, storage, liczbaWierzcholkow, stride)) {
+            return true;
+        }
+        cerr << "Niepoprawny plik binarny " << filename << endl;
+        return false;
+    }
+    MappedFile plik;
+    if (!plik.open(filename)) {
+        cerr << "Nie udało się otworzyć pliku." << endl;
+        return false;
+    }
+    TsplibParser parser(plik.data(), plik.size());
+    TsplibHeader naglowek;
+    if (parser.readHeader(naglowek)) {
+        Weight* data = allocate(naglowek.dimension);
+        if (parser.readWeights(naglowek, data, stride, pool)) {
+            writeInstanceCache(filename, getView()); // Błąd zapisu kopii nie przeszkadza w dalszej pracy.
+            return true;
+        }
+    }
+    cerr << "Niepoprawny plik " << filename << ": " << parser.getError() << endl;
+    storage.reset();
+    liczbaWierzcholkow = 0;
+    stride = 0;
+    return false;
+}
+void Adjacency_Matrix::generate(int numberOfNodes){
+    generate(numberOfNodes, (uint64_t)random_device()() << 32 | random_device()()); // Bez przestawiania globalnego rand().
+}
+void Adjacency_Matrix::generate(int numberOfNodes, uint64_t seed){
+    Random rng(seed);
+    Weight* data = allocate(numberOfNodes);
+    for (int j = 0; j < numberOfNodes; j++){
+        for (int i = 0; i < numberOfNodes; i++) {
+            if(i==j)
+                data[(size_t)j * stride + i] = -1;
+            else data[(size_t)j * stride + i] = rng.below(101) + 1;
+        }
+    }
+}
+// Każdy wiersz liczony jest niezależnie z generatora, więc wynik nie zależy od liczby wątków.
+void Adjacency_Matrix::generate(const InstanceGenerator& generator, WorkerPool* pool){
+    Weight* data = allocate(generator.size());
+    const int tasks = pool != nullptr ? pool->size() : 1;
+    const function<void(int)> fill = [&](int task) {
+        for (int row = task; row < liczbaWierzcholkow; row += tasks) {
+            generator.fillRow(row, data + (size_t)row * stride);
+        }
+    };
+    if (pool != nullptr) {
+        pool->run(tasks, fill);
+    } else {
+        fill(0);
+    }
+}
+// Wagi spoza przekątnej muszą mieścić się w typie Weight; inaczej macierz nie jest przyjmowana.
+bool Adjacency_Matrix::assign(const int* weights, int numberOfNodes){
+    Weight* data = allocate(numberOfNodes);
+    for (int i = 0; i < numberOfNodes; i++) {
+        for (int j = 0; j < numberOfNodes; j++) {
+            const int weight = weights[(size_t)i * numberOfNodes + j];
+            if (i != j && !fitsWeight(weight)) {
+                cerr << "Waga " << weight << " poza zakresem typu wag (maksymalnie " << WEIGHT_MAX << ")" << endl;
+                storage.reset();
+                liczbaWierzcholkow = 0;
+                stride = 0;
+                return false;
+            }
+            data[(size_t)i * stride + j] = clampWeight(weight);
+        }
+    }
+    return true;
+}
+MatrixView Adjacency_Matrix::getView() const {
+    MatrixView view;
+    view.data = storage.get();
+    view.n = liczbaWierzcholkow;
+    view.stride = stride;
+    return view;
+}
+int Adjacency_Matrix::getNumVertices() const {
+    return liczbaWierzcholkow;
+}
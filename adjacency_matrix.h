@@ -1,28 +1,44 @@
-#ifndef PEA1_ADJACENCY_MATRIX_H
-#define PEA1_ADJACENCY_MATRIX_H
-#pragma once
-
-#include <math.h>
-#include <algorithm>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <cstdlib>
-
-using namespace std;
-
-class Adjacency_Matrix {
-public:
-    Adjacency_Matrix();
-    void printMatrix();
-    void loadFromFile(const string& filename);
-    vector<vector<int>> getMatrix();
-    void generate(int numberOfNodes);
-    int getNumVertices();
-private:
-    vector<vector<int>> matrix;
-    int liczbaWierzcholkow;
-};
-
-
-#endif //PEA1_ADJACENCY_MATRIX_H
+#ifndef PEA1_ADJACENCY_MATRIX_H
+#define PEA1_ADJACENCY_MATRIX_H
+#pragma once
+
+#include <math.h>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <memory>
+#include <cstdint>
+#include "DistanceMatrix.h"
+
+class InstanceGenerator;
+class WorkerPool;
+
+// Właściciel macierzy odległości. Dane leżą w jednym buforze wierszami (row-major),
+// z wyrównaniem do 64 bajtów i wierszami dopełnionymi do wielokrotności linii cache.
+// Kopie obiektu współdzielą ten sam bufor, a solvery czytają go przez MatrixView.
+// Bufor może też być zmapowaną kopią binarną instancji (InstanceCache.h) albo samodzielnym
+// plikiem ".bin" zapisanym przez generator (Generator.h) albo cudzym buforem (konstruktor
+// z MatrixView), który wtedy nie jest zwalniany.
+class Adjacency_Matrix {
+public:
+    Adjacency_Matrix();
+    explicit Adjacency_Matrix(const MatrixView& view); // Bez kopiowania; właściciel bufora musi żyć dłużej.
+    void printMatrix();
+    bool loadFromFile(const std::string& filename, WorkerPool* pool = nullptr); // Macierz ze współrzędnych równolegle na puli.
+    MatrixView getView() const;
+    void generate(int numberOfNodes);
+    void generate(int numberOfNodes, uint64_t seed); // Powtarzalna instancja dla danego ziarna.
+    void generate(const InstanceGenerator& generator, WorkerPool* pool = nullptr); // Wiersze równolegle na puli.
+    bool assign(const int* weights, int numberOfNodes); // Kopia macierzy n x n zapisanej wierszami bez dopełnienia.
+    int getNumVertices() const;
+private:
+    Weight* allocate(int numberOfNodes);
+    std::shared_ptr<const Weight> storage;
+    int liczbaWierzcholkow = 0;
+    int stride = 0;
+};
+
+
+#endif //PEA1_ADJACENCY_MATRIX_H
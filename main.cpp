@@ -1,19 +1,32 @@
 #include <iostream>
+#include <random>
+#include <thread>
 #include "adjacency_matrix.h"
 #include "SimulatedAnnealing.h"
 #include "TabuSearch.h"
+#include "ParallelSolver.h"
+#include "ExactSolver.h"
+#include "Batch.h"
 
+using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return runBatch(argc, argv); // Tryb wsadowy sterowany argumentami zamiast menu.
+    }
     Adjacency_Matrix graf;
     graf.loadFromFile("ftv55.atsp");
     string dane,wynik;
     int searchTime=5;
     srand(static_cast<unsigned int>(time(nullptr)));
+    uint64_t ziarno = random_device()(); // Ziarno generatorów solverów; stałe ziarno daje powtarzalne przebiegi.
     double coolingRate=0.99;
     int opcja;
+    Neighborhood sasiedztwo; // Domyślnie pełny przegląd / losowa zamiana par.
+    shared_ptr<const CandidateLists> szlifowanie; // Listy dla przeszukiwania lokalnego (null - wyłączone).
+    double coIleSzlifowac = 0;
     do {
-        SimulatedAnnealing sa(graf, searchTime, coolingRate);
+        SimulatedAnnealing sa(graf, searchTime, coolingRate, ziarno);
         cout << "Wybierz opcje:" << endl;
         cout << "1. Wczytaj dane z pliku" << endl;
         cout << "2. Wyprowadz kryterium stopu" << endl;
@@ -22,6 +35,11 @@ int main() {
         cout << "5. Algorytm SimulatedAnnealing "<< endl;
         cout << "6. Zapisz dane do pliku" << endl;
         cout << "7. Wczytaj sciezke z pliku i oblicz koszt "<<endl;
+        cout << "8. Rownolegle TS/SA/wymiana replik/memetyczny na wielu watkach" << endl;
+        cout << "9. Wybierz sasiedztwo (zamiana / Or-opt / or-3opt)" << endl;
+        cout << "10. Optymalizacja lokalna najlepszej trasy (Or-opt + or-3opt)" << endl;
+        cout << "11. Ustaw ziarno generatora liczb losowych" << endl;
+        cout << "12. Rozwiazanie dokladne (Held-Karp / podzial i ograniczenia)" << endl;
         cout << "0. Zakoncz program"<<endl;
         cin >> opcja;
         switch (opcja) {
@@ -29,6 +47,8 @@ int main() {
                 cout<<"podaj nazwe pliku: ";
                 cin>>dane;
                 graf.loadFromFile(dane);
+                sasiedztwo = Neighborhood(); // Listy kandydatów dotyczyły poprzedniej instancji.
+                szlifowanie.reset();
                 break;
             }
             case 2: {
@@ -37,7 +57,12 @@ int main() {
                 break;
             }
             case 3: {
-                TabuSearch tabuSearch(graf, searchTime);
+                TabuSearch tabuSearch(graf, searchTime, ziarno);
+                tabuSearch.setScanThreads((int)thread::hardware_concurrency());
+                tabuSearch.setNeighborhood(sasiedztwo);
+                if (szlifowanie != nullptr) {
+                    tabuSearch.setPolish(szlifowanie, coIleSzlifowac);
+                }
                 tabuSearch.apply();
                 break;
             }
@@ -47,6 +72,10 @@ int main() {
                 break;
             }
             case 5: {
+                sa.setNeighborhood(sasiedztwo);
+                if (szlifowanie != nullptr) {
+                    sa.setPolish(szlifowanie, coIleSzlifowac);
+                }
                 sa.apply();
                 break;
             }
@@ -59,6 +88,79 @@ int main() {
                 cout<<sa.calculatePath(sa.loadPathFromFile(wynik))<<endl;
                 break;
             }
+            case 8: {
+                ParallelOptions options;
+                int algorytm, wyspy;
+                cout<<"Algorytm (1 - TabuSearch, 2 - SimulatedAnnealing, 3 - wymiana replik SA, 4 - memetyczny, 5 - dokladny): ";
+                cin>>algorytm;
+                cout<<"Liczba watkow (0 - wszystkie rdzenie): ";
+                cin>>options.threads;
+                cout<<"Model wyspowy (0 - nie, 1 - tak): ";
+                cin>>wyspy;
+                if (wyspy == 1) {
+                    cout<<"Co ile sekund migracja: ";
+                    cin>>options.migrationInterval;
+                }
+                options.kind = algorytm == 5 ? SolverKind::Exact
+                             : algorytm == 4 ? SolverKind::Memetic
+                             : algorytm == 3 ? SolverKind::ParallelTempering
+                             : algorytm == 2 ? SolverKind::SimulatedAnnealing : SolverKind::TabuSearch;
+                options.islands = wyspy == 1;
+                options.searchTime = searchTime;
+                options.coolingRate = coolingRate;
+                options.seed = ziarno;
+                options.neighborhood = sasiedztwo;
+                options.polish = szlifowanie != nullptr;
+                options.polishInterval = coIleSzlifowac;
+                Tour najlepsza = solveParallel(graf, options);
+                cout << "Droga: ";
+                for (int wierzcholek : najlepsza.path) {
+                    cout << wierzcholek << " ";
+                }
+                cout << "\nKoszt: " << najlepsza.cost << endl;
+                cout << "Znaleziono po: " << najlepsza.foundTime << " s " << endl;
+                break;
+            }
+            case 9: {
+                int rodzaj, kandydaci = 10;
+                cout<<"Sasiedztwo (0 - pelna zamiana par, 1 - zamiana, 2 - Or-opt, 3 - or-3opt): ";
+                cin>>rodzaj;
+                if (rodzaj >= 1 && rodzaj <= 3) {
+                    cout<<"Liczba najblizszych kandydatow (proponowane 10): ";
+                    cin>>kandydaci;
+                }
+                const NeighborhoodKind rodzaje[] = {NeighborhoodKind::FullSwap, NeighborhoodKind::Swap,
+                                                    NeighborhoodKind::OrOpt, NeighborhoodKind::Or3Opt};
+                sasiedztwo = Neighborhood(graf.getView(), rodzaje[rodzaj >= 0 && rodzaj <= 3 ? rodzaj : 0], kandydaci);
+                break;
+            }
+            case 10: {
+                int wlacz;
+                cout<<"Optymalizacja lokalna (0 - wylacz, 1 - wlacz): ";
+                cin>>wlacz;
+                if (wlacz != 1) {
+                    szlifowanie.reset();
+                    break;
+                }
+                cout<<"Co ile sekund na najlepszej trasie (0 - tylko na koncu): ";
+                cin>>coIleSzlifowac;
+                szlifowanie = sasiedztwo.candidateLists();
+                if (szlifowanie == nullptr) {
+                    szlifowanie = make_shared<const CandidateLists>(graf.getView(), 10);
+                }
+                break;
+            }
+            case 11: {
+                cout<<"Podaj ziarno: ";
+                cin>>ziarno;
+                break;
+            }
+            case 12: {
+                ExactSolver dokladny(graf, searchTime);
+                dokladny.setThreads((int)thread::hardware_concurrency());
+                dokladny.apply();
+                break;
+            }
         }
 
     } while (opcja != 0);